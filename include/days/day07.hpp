@@ -15,6 +15,12 @@
  * numbers of invalid operator combinations early, vastly outperforming pre-computing
  * sequences left-to-right.
  *
+ * For long operand lists (synthetic inputs with 20-30 operands) the 3^n branching
+ * outgrows even the pruned recursion, so equations above a fixed operand count are
+ * handed to a meet-in-the-middle solver: the front half is enumerated forward, the
+ * back half is undone backward from the test_value, and the two sides are joined
+ * through a hash set.
+ *
  * Part 1: Use only two operators: + (addition) and * (multiplication)
  * Part 2: Use three operators: + (addition), * (multiplication), and || (concatenation)
  */
@@ -43,6 +49,20 @@ struct Equation {
  */
 std::vector<Equation> parse_input(const std::vector<std::string>& input);
 
+/**
+ * @brief Checks an equation by meeting in the middle of its operand list
+ *
+ * Enumerates every value reachable from the first half of the operands (left to
+ * right, pruning anything above test_value), then applies the reverse operators
+ * of the second half to test_value (right to left). The equation is valid if the
+ * two value sets intersect. Cost is roughly 3^(n/2) per side instead of 3^n.
+ *
+ * @param equation Equation to check (operands must be positive)
+ * @param allow_concat Whether the || operator is available (part 2)
+ * @return true if some operator assignment yields test_value
+ */
+[[nodiscard]] bool is_valid_equation_meet_in_the_middle(const Equation& equation, bool allow_concat);
+
 /**
  * @brief Solves part 1 of day 7's puzzle
  * @param input Vector of strings representing the puzzle input
@@ -54,10 +54,11 @@
  * 1. Same parsing and grouping as Part 1
  *
  * 2. For each frequency with 2+ antennas, for each pair (A, B):
- *    a. Calculate the direction vector: delta = B - A
- *    b. Extend the line in BOTH directions from both antennas:
- *       - From A: go in direction -delta (opposite to B) until out of bounds
- *       - From B: go in direction +delta (towards and past B) until out of bounds
+ *    a. Calculate the direction vector: delta = B - A, reduced by
+ *       gcd(|dx|, |dy|) so cells between the antennas are not skipped
+ *    b. Extend the line in BOTH directions:
+ *       - From A: go in direction -delta (away from B) until out of bounds
+ *       - From A: go in direction +delta (through and past B) until out of bounds
  *       - HINT: Use a while loop with bounds checking
  *
  *    c. Add all valid positions to the antinode set
@@ -75,15 +76,61 @@
  * - Antinodes at antenna positions (valid in both parts)
  * - Antinodes outside map bounds (must be excluded)
  * - Multiple antenna pairs creating antinodes at same location (use set to dedupe)
+ *
+ * SPARSE MODE:
+ * ============
+ * City-scale maps (10^6 x 10^6 cells, millions of antennas) cannot be held as a
+ * character grid or a dense bitmap. The sparse mode reads the map as a list of
+ * antenna coordinates, hands (frequency, first antenna) rows to worker threads
+ * and deduplicates antinodes through a sharded open-addressing hash set, so
+ * memory grows with the number of distinct antinodes rather than the map area.
+ * Resonant lines are walked with gcd-reduced steps, so every lattice point that
+ * is exactly collinear with a pair is counted.
  */
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
 namespace aoc::day08 {
 
+/**
+ * @brief A single antenna in a sparse map
+ */
+struct Antenna {
+    char frequency;
+    std::int64_t x;
+    std::int64_t y;
+};
+
+/**
+ * @brief Antenna map given as a coordinate list instead of a character grid
+ */
+struct SparseMap {
+    std::int64_t width;
+    std::int64_t height;
+    std::vector<Antenna> antennas;
+};
+
+/**
+ * @brief Parses a sparse antenna list
+ * @param input First line "width height", then one "frequency x y" line per antenna
+ * @return The parsed map
+ * @throws std::runtime_error if the header or an antenna line is malformed
+ */
+[[nodiscard]] SparseMap parse_sparse_map(const std::vector<std::string>& input);
+
+/**
+ * @brief Counts unique antinodes of a sparse map using several threads
+ * @param map Map dimensions and antenna list
+ * @param resonant false for part 1 rules, true for part 2 (whole resonant lines)
+ * @param thread_count Worker count, 0 = std::thread::hardware_concurrency()
+ * @return Number of distinct in-bounds antinode cells
+ */
+[[nodiscard]] std::size_t count_antinodes_sparse(const SparseMap& map, bool resonant, unsigned thread_count = 0);
+
 /**
  * @brief Solves part 1: Count unique antinode locations with basic rules
  * @param input Vector of strings representing the antenna map
@@ -27,7 +27,15 @@
 
 #pragma once
 
+#include "utils/math_utils.hpp"
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <queue>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace aoc::day09 {
@@ -38,13 +46,66 @@ namespace aoc::day09 {
  * @return String representation of the filesystem checksum
  *
  * ALGORITHM STRATEGY:
- * 1. Parse the disk map into a representation of the disk (array of blocks)
- * 2. Use two pointers: one from left finding free space, one from right finding file blocks
- * 3. Swap blocks until pointers meet
- * 4. Calculate checksum by iterating through the compacted disk
+ * Delegates to compact_blocks_checksum(), which runs the two-pointer compaction
+ * over the disk map digits themselves instead of an expanded block array.
  */
 [[nodiscard]] std::string solve_part1(const std::vector<std::string>& input);
 
+/**
+ * @brief Part 1 checksum computed directly on the disk map spans
+ *
+ * A left cursor walks the map in order; file digits are emitted in place and
+ * free digits are filled from a right cursor that consumes the right-most file
+ * span block by block. Each emitted run adds file_id * (sum of its positions)
+ * via the arithmetic-series formula, so no block array is ever built.
+ *
+ * Memory: O(1) beyond the map itself. Time: O(map length).
+ *
+ * @param disk_map The disk map digits (anything after the first non-digit is ignored)
+ * @return Exact filesystem checksum (128-bit, as 10^8-digit maps overflow 64 bits)
+ */
+[[nodiscard]] aoc::utils::int128 compact_blocks_checksum(std::string_view disk_map);
+
+/**
+ * @brief Part 2 checksum without materialising the span lists
+ *
+ * Keeps one forward cursor per file length 1-9 pointing at the leftmost free
+ * span that may still hold such a file (these only ever move right, because
+ * free spans only shrink) and one backward cursor over the files. A span too
+ * small for L-1 blocks is too small for L, so the cursors are kept ordered by
+ * length. A partially filled span is dropped once the cursor of the shortest
+ * file length still to be placed has passed it, so memory is bounded by the
+ * partially filled spans between that cursor and the length-9 cursor.
+ *
+ * @param disk_map The disk map digits (anything after the first non-digit is ignored)
+ * @param peak_partial_spans If non-null, receives the largest number of
+ *        partially filled spans remembered at once
+ * @return Exact filesystem checksum after whole-file compaction
+ */
+[[nodiscard]] aoc::utils::int128 compact_files_checksum(std::string_view disk_map,
+                                                        std::size_t* peak_partial_spans = nullptr);
+
+/**
+ * @brief Streams the part 1 checksum from a memory-mapped disk map file
+ *
+ * The file is never copied into a std::string: compact_blocks_checksum() runs
+ * its forward (free space) and backward (file) cursors directly on the mapping.
+ *
+ * @param filepath Path to a file holding the disk map digits
+ * @return Exact part 1 checksum
+ * @throws std::runtime_error if the file cannot be opened or mapped
+ */
+[[nodiscard]] aoc::utils::int128 stream_part1_checksum(const std::string& filepath);
+
+/**
+ * @brief Streams the part 2 checksum from a memory-mapped disk map file
+ *
+ * @param filepath Path to a file holding the disk map digits
+ * @return Exact part 2 checksum, computed by compact_files_checksum()
+ * @throws std::runtime_error if the file cannot be opened or mapped
+ */
+[[nodiscard]] aoc::utils::int128 stream_part2_checksum(const std::string& filepath);
+
 /**
  * @brief Solves part 2: Whole-file compaction
  * @param input Vector of strings representing the puzzle input (single line of digits)
@@ -52,10 +113,11 @@ namespace aoc::day09 {
  *
  * ALGORITHM STRATEGY:
  * 1. Parse the disk map, tracking file positions and free space spans
- * 2. Process files from highest ID to lowest
- * 3. For each file, find the leftmost free span that can fit it entirely
- * 4. If found, move the whole file to that span
- * 5. Calculate checksum on the final arrangement
+ * 2. Index the free spans by length (FreeSpanIndex)
+ * 3. Process files from highest ID to lowest
+ * 4. For each file, take the leftmost free span that can fit it entirely
+ * 5. If found, move the whole file to that span
+ * 6. Sum the closed-form checksum of every file span
  */
 [[nodiscard]] std::string solve_part2(const std::vector<std::string>& input);
 
@@ -153,6 +215,58 @@ struct Span {
     int max_position
 );
 
+/**
+ * @brief Free spans bucketed by length for O(log n) best-fit-leftmost queries
+ *
+ * Holds one min-heap of start positions per span length (1-9, the largest a
+ * single disk map digit can describe). A query for a file of length L only has
+ * to compare the tops of the heaps for lengths L..9 and take the leftmost one,
+ * replacing the linear scan of find_suitable_free_span.
+ */
+class FreeSpanIndex {
+public:
+    /**
+     * @brief Builds the index from a list of free spans (empty spans are ignored)
+     * @throws std::invalid_argument if a span is longer than kMaxSpanLength
+     */
+    explicit FreeSpanIndex(const std::vector<Span>& free_spans);
+
+    /**
+     * @brief Removes and returns the leftmost span that fits a file
+     *
+     * The part of the span not used by the file is re-indexed under its new
+     * (shorter) length.
+     *
+     * @param required_length File length to place (0 to kMaxSpanLength)
+     * @param max_position The file's current start position (don't move right!)
+     * @return Start position of the placed file, or std::nullopt if no span fits
+     * @throws std::invalid_argument if required_length is out of range
+     */
+    [[nodiscard]] std::optional<int> allocate(int required_length, int max_position);
+
+    /**
+     * @brief Adds a free span to the index
+     * @throws std::invalid_argument if the span is longer than kMaxSpanLength
+     */
+    void add(const Span& span);
+
+    /// Longest span a single disk map digit can describe
+    static constexpr int kMaxSpanLength = 9;
+
+private:
+    std::array<std::priority_queue<int, std::vector<int>, std::greater<>>, kMaxSpanLength + 1> heaps_;
+};
+
+/**
+ * @brief Checksum contribution of a single file span
+ *
+ * Closed form of file_id * (start + (start + 1) + ... + (start + length - 1)).
+ *
+ * @param file File span (file_id must be >= 0)
+ * @return file_id * (start * length + length * (length - 1) / 2)
+ */
+[[nodiscard]] long long span_checksum(const Span& file);
+
 /**
  * @brief Alternative approach: Parse disk into file spans and free spans
  *
@@ -2,18 +2,127 @@
 
 /**
  * @file day10.hpp
- * @brief Day 10: [TODO - Beschreibung des Puzzles]
+ * @brief Day 10: Hoof It
  *
- * [TODO - Detaillierte Beschreibung des Puzzles]
- * Part 1: [TODO - Beschreibung von Teil 1]
- * Part 2: [TODO - Beschreibung von Teil 2]
+ * A topographic map gives a height 0-9 per cell. A hiking trail starts at a
+ * 0 (trailhead), ends at a 9 and climbs by exactly 1 with every orthogonal step.
+ *
+ * Part 1: Sum over trailheads of the number of distinct 9s reachable (score).
+ * Part 2: Sum over trailheads of the number of distinct trails (rating).
+ *
+ * ALGORITHMIC APPROACH:
+ * Both parts come from one sweep over the height layers 9 down to 0 on a flat
+ * uint8_t grid. Every cell of height h combines the results of its height h+1
+ * neighbours: a path count (part 2) and the set of reachable 9s (part 1), kept
+ * as a bitset over all 9s when that fits the memory budget and as a sorted
+ * sparse list otherwise. No recursion is involved and only two layers of
+ * reachability sets are alive at any time.
+ *
+ * QUERIES UNDER EDITS:
+ * TrailIndex keeps per-cell trail counts in both directions and per-cell
+ * reachable-9 lists, so scores and ratings are O(1) lookups. Changing one
+ * cell's height only changes the values of cells that can climb to it (the
+ * downward cone) and cells it can climb to (the upward cone); since trails
+ * are at most 9 steps long both cones stay within a small diamond around the
+ * edited cell and are recomputed layer by layer.
  */
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
 namespace aoc::day10 {
 
+/// Default memory allowed for two layers of dense reachability bitsets
+inline constexpr std::size_t kDenseBudgetBytes = std::size_t{64} << 20;
+
+/**
+ * @brief Results of the layered sweep over a topographic map
+ */
+struct TrailTotals {
+    long long score_sum;  ///< Sum of trailhead scores (part 1)
+    long long rating_sum; ///< Sum of trailhead ratings (part 2)
+};
+
+/**
+ * @brief Computes trailhead scores and ratings in one layered sweep
+ * @param input Topographic map rows; non-digit cells are impassable
+ * @param dense_budget_bytes Largest footprint of the two live bitset layers;
+ *        maps that need more use the sparse per-cell lists instead
+ * @return Score and rating totals over all trailheads
+ */
+[[nodiscard]] TrailTotals analyze_trails(const std::vector<std::string>& input,
+                                         std::size_t dense_budget_bytes = kDenseBudgetBytes);
+
+/**
+ * @brief Trail score/rating index that supports single-cell height edits
+ */
+class TrailIndex {
+public:
+    /**
+     * @brief Precomputes all per-cell trail counts and reachable-9 lists
+     * @param input Topographic map rows; non-digit cells are impassable
+     */
+    explicit TrailIndex(const std::vector<std::string>& input);
+
+    /**
+     * @brief Number of distinct trails climbing from (row, col) to any 9
+     *
+     * For a trailhead this is its rating.
+     *
+     * @throws std::invalid_argument if (row, col) lies outside the map; the
+     *         other per-cell queries and set_height() check the same way
+     */
+    [[nodiscard]] long long rating(int row, int col) const;
+
+    /**
+     * @brief Number of distinct 9s reachable from (row, col)
+     *
+     * For a trailhead this is its score.
+     */
+    [[nodiscard]] long long score(int row, int col) const;
+
+    /**
+     * @brief Number of distinct trails from any trailhead that reach (row, col)
+     */
+    [[nodiscard]] long long trails_ending_at(int row, int col) const;
+
+    /// Sum of ratings over all trailheads (part 2)
+    [[nodiscard]] long long total_rating() const;
+
+    /// Sum of scores over all trailheads (part 1)
+    [[nodiscard]] long long total_score() const;
+
+    /**
+     * @brief Changes the height of one cell and repairs the affected cones
+     * @param row Cell row
+     * @param col Cell column
+     * @param height New height '0'-'9', anything else makes the cell impassable
+     * @throws std::invalid_argument if (row, col) lies outside the map
+     */
+    void set_height(int row, int col, char height);
+
+private:
+    int rows_ = 0;
+    int cols_ = 0;
+    std::vector<std::uint8_t> heights_;
+    std::vector<long long> up_;                    ///< Trails from the cell up to any 9
+    std::vector<long long> down_;                  ///< Trails from any 0 up to the cell
+    std::vector<std::vector<std::uint32_t>> nines_; ///< Sorted reachable 9 cells
+    long long total_rating_ = 0;
+    long long total_score_ = 0;
+
+    // Scratch for collecting cones, reused across edits
+    std::vector<std::uint32_t> visited_epoch_;
+    std::uint32_t epoch_ = 0;
+
+    [[nodiscard]] std::uint32_t index_of(int row, int col) const;
+    void recompute_up(std::uint32_t index);
+    void recompute_down(std::uint32_t index);
+    [[nodiscard]] std::vector<std::uint32_t> collect_cone(const std::vector<std::uint32_t>& seeds, int step);
+};
+
 /**
  * @brief Solves part 1 of day 10's puzzle
  * @param input Vector of strings representing the puzzle input
@@ -28,4 +137,4 @@ std::string solve_part1(const std::vector<std::string>& input);
  */
 std::string solve_part2(const std::vector<std::string>& input);
 
-} // namespace aoc::day10
\ No newline at end of file
+} // namespace aoc::day10
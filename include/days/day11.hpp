@@ -15,13 +15,132 @@
  *
  * Part 1: How many stones will you have after blinking 25 times?
  * Part 2: How many stones will you have after blinking 75 times?
+ *
+ * ALGORITHMIC APPROACH:
+ * Stone order never matters, only how many stones carry each value. Every
+ * distinct value is interned once into a small integer id (open-addressing
+ * table) together with the ids of its children, so a blink is a pass over the
+ * currently present ids that adds counts into a second, pre-allocated array.
+ * The set of values reachable from the input closes after a few thousand ids,
+ * after which blinking allocates nothing.
+ *
+ * ARBITRARY DEPTH:
+ * Because that closed set is finite, the total stone count after n blinks is
+ * a linear recurrent sequence (the transition graph is a fixed sparse matrix
+ * M and count_n = 1^T M^n v0). Modulo a prime, the shortest recurrence is
+ * recovered with Berlekamp-Massey from the first 2 * |values| totals, and the
+ * n-th term is evaluated by polynomial exponentiation modulo the recurrence's
+ * characteristic polynomial (Kitamasa), i.e. in O(log n) polynomial steps.
+ *
+ * PARALLEL BLINKING:
+ * For inputs with very many distinct stones, count_stones_parallel() hash-
+ * partitions values across workers. Each worker transforms its own shard into
+ * per-destination outboxes and, after one barrier per blink, merges the
+ * outboxes addressed to it; no other synchronization is needed.
  */
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
 namespace aoc::day11 {
 
+/**
+ * @brief Parses the space-separated stone values
+ * @param input Puzzle input (first line holds the stones)
+ * @return Stone values in input order
+ */
+[[nodiscard]] std::vector<std::uint64_t> parse_stones(const std::vector<std::string>& input);
+
+/**
+ * @brief Frequency-based blink simulator with a shared transition cache
+ *
+ * Counts are unsigned 64-bit and wrap modulo 2^64 once the stone count
+ * exceeds it (beyond roughly 120 blinks for typical inputs).
+ */
+class BlinkEngine {
+public:
+    /**
+     * @brief Starts a simulation from the given stones
+     */
+    explicit BlinkEngine(const std::vector<std::uint64_t>& stones);
+
+    /**
+     * @brief Applies the rules to every stone `times` times
+     */
+    void blink(int times);
+
+    /**
+     * @brief Total number of stones after the blinks so far
+     */
+    [[nodiscard]] std::uint64_t stone_count() const;
+
+    /**
+     * @brief Number of distinct stone values interned so far
+     */
+    [[nodiscard]] std::size_t distinct_values() const;
+
+private:
+    static constexpr std::uint32_t kNone = 0xFFFFFFFFu;
+
+    /// Children of a stone; right is kNone unless the stone splits
+    struct Transition {
+        std::uint32_t left = kNone;
+        std::uint32_t right = kNone;
+    };
+
+    std::vector<std::uint64_t> values_;       ///< id -> stone value
+    std::vector<Transition> transitions_;     ///< id -> children (left == kNone until first use)
+    std::vector<std::uint32_t> slots_;        ///< open-addressing table of ids
+    std::vector<std::uint64_t> counts_;       ///< id -> stones with that value now
+    std::vector<std::uint64_t> next_counts_;  ///< id -> stones after the current blink
+    std::vector<std::uint32_t> active_;       ///< ids with a non-zero count
+    std::vector<std::uint32_t> next_active_;
+
+    [[nodiscard]] std::uint32_t intern(std::uint64_t value);
+    [[nodiscard]] const Transition& transition(std::uint32_t id);
+    void grow_table();
+};
+
+/**
+ * @brief Number of stones after `blinks` blinks using sharded worker threads
+ *
+ * Equivalent to BlinkEngine (including wrap-around modulo 2^64), but each
+ * worker owns the values whose hash maps to it, so large, diverse inputs scale
+ * across cores.
+ *
+ * @param stones Initial stone values
+ * @param blinks Number of blinks
+ * @param thread_count Worker count, 0 = std::thread::hardware_concurrency()
+ * @return Total number of stones
+ */
+[[nodiscard]] std::uint64_t count_stones_parallel(const std::vector<std::uint64_t>& stones, int blinks,
+                                                  unsigned thread_count = 0);
+
+/**
+ * @brief Number of stones after any number of blinks, modulo a prime
+ * @param stones Initial stone values
+ * @param blinks Number of blinks (up to 2^64 - 1)
+ * @param modulus Prime modulus below 2^62
+ * @return Stone count modulo `modulus`
+ * @throws std::invalid_argument if the modulus is out of range
+ */
+[[nodiscard]] std::uint64_t count_stones_mod(const std::vector<std::uint64_t>& stones, std::uint64_t blinks,
+                                             std::uint64_t modulus);
+
+/**
+ * @brief Exact number of stones after a number of blinks, as a decimal string
+ *
+ * Runs the closed transition graph with arbitrary-precision counts. The cost
+ * grows with blinks^2 (counts gain about 0.6 bits per blink), which is fine for
+ * ~10^4 blinks; use count_stones_mod() for deeper runs.
+ *
+ * @param stones Initial stone values
+ * @param blinks Number of blinks
+ * @return Decimal representation of the stone count
+ */
+[[nodiscard]] std::string count_stones_exact(const std::vector<std::uint64_t>& stones, std::uint64_t blinks);
+
 /**
  * @brief Solves part 1 of day 11's puzzle
  * @param input Vector of strings representing the puzzle input
@@ -36,4 +155,4 @@ std::string solve_part1(const std::vector<std::string>& input);
  */
 std::string solve_part2(const std::vector<std::string>& input);
 
-} // namespace aoc::day11
\ No newline at end of file
+} // namespace aoc::day11
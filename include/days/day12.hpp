@@ -11,13 +11,118 @@
  *
  * Part 1: Price = Sum of (Area * Perimeter) for all regions.
  * Part 2: Price = Sum of (Area * Number of Sides) for all regions.
+ *
+ * ALGORITHMIC APPROACH:
+ * One raster scan labels regions with union-find (a cell joins its upper and
+ * left neighbours of the same plant). In the same pass every cell adds its
+ * area and exposed edges to its provisional label, and every grid vertex looks
+ * at the 2x2 window of cells around it: a region has a corner there when it
+ * covers one or three of the four cells (or two diagonal ones). A region has
+ * as many sides as corners, so both prices fall out of one linear pass.
+ *
+ * PARALLEL LABELING:
+ * Large maps are cut into row bands that are labelled independently. A final
+ * merge unites labels across each seam and counts the corners at the seam's
+ * vertices, whose 2x2 windows straddle two bands.
+ *
+ * INCREMENTAL EDITS:
+ * A cell's share of its region's perimeter and corners depends only on the
+ * plants in its 3x3 neighbourhood, so a region's statistics are sums of
+ * per-cell terms. GardenIndex keeps a region label per cell; changing one
+ * plant re-evaluates the nine affected terms and then splits the old region
+ * or merges neighbouring regions as needed.
  */
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
 namespace aoc::day12 {
 
+/**
+ * @brief Fence statistics of one region
+ */
+struct RegionStats {
+    char plant = 0;
+    std::int64_t area = 0;
+    std::int64_t perimeter = 0;
+    std::int64_t sides = 0; ///< Equal to the number of corners
+};
+
+/**
+ * @brief Labels all regions in a single raster pass
+ * @param grid Garden map (rectangular, one string per row)
+ * @return Statistics for every region, in order of each region's first cell
+ */
+[[nodiscard]] std::vector<RegionStats> analyze_regions(const std::vector<std::string>& grid);
+
+/**
+ * @brief Same as analyze_regions(), labelling row bands on worker threads
+ * @param grid Garden map (rectangular, one string per row)
+ * @param thread_count Worker count, 0 = std::thread::hardware_concurrency()
+ * @return Statistics for every region, in order of each region's first cell
+ */
+[[nodiscard]] std::vector<RegionStats> analyze_regions_parallel(const std::vector<std::string>& grid,
+                                                                unsigned thread_count = 0);
+
+/**
+ * @brief Region labels and fence prices that follow single-cell edits
+ */
+class GardenIndex {
+public:
+    /**
+     * @brief Labels the map and computes every region's statistics
+     */
+    explicit GardenIndex(const std::vector<std::string>& grid);
+
+    /**
+     * @brief Changes the plant of one cell and updates the affected regions
+     * @throws std::out_of_range if the cell is outside the map
+     */
+    void set_plant(std::size_t row, std::size_t col, char plant);
+
+    [[nodiscard]] char plant(std::size_t row, std::size_t col) const;
+
+    /**
+     * @brief Statistics of the region containing a cell
+     */
+    [[nodiscard]] const RegionStats& region_at(std::size_t row, std::size_t col) const;
+
+    [[nodiscard]] std::size_t region_count() const;
+
+    /// Part 1 price: sum of area * perimeter
+    [[nodiscard]] std::int64_t perimeter_price() const;
+
+    /// Part 2 price: sum of area * sides
+    [[nodiscard]] std::int64_t sides_price() const;
+
+private:
+    std::size_t rows_ = 0;
+    std::size_t cols_ = 0;
+    std::vector<char> plants_;             ///< Row-major plants
+    std::vector<std::uint32_t> labels_;    ///< Row-major region ids
+    std::vector<RegionStats> regions_;     ///< Region id -> statistics (area 0 = unused)
+    std::vector<std::uint32_t> free_ids_;  ///< Unused region ids
+    std::size_t live_regions_ = 0;
+    std::int64_t perimeter_price_ = 0;
+    std::int64_t sides_price_ = 0;
+
+    // Epoch-stamped search marks for split detection
+    std::vector<std::uint32_t> mark_epoch_;
+    std::vector<std::uint8_t> mark_search_;
+    std::uint32_t epoch_ = 0;
+
+    [[nodiscard]] char plant_or_outside(std::size_t row, std::size_t col) const;
+    [[nodiscard]] RegionStats cell_terms(std::size_t index) const;
+    void add_terms(std::uint32_t region, const RegionStats& terms, int sign);
+    [[nodiscard]] std::uint32_t new_region(char plant);
+    void release_region(std::uint32_t region);
+    void split_region(std::size_t removed, char plant, const std::vector<std::size_t>& window,
+                      std::vector<std::uint32_t>& touched);
+    void relabel(std::size_t start, std::uint32_t from, std::uint32_t to);
+};
+
 /**
  * @brief Solves part 1 of day 12's puzzle
  * @param input Vector of strings representing the puzzle input
@@ -32,4 +137,4 @@ std::string solve_part1(const std::vector<std::string>& input);
  */
 std::string solve_part2(const std::vector<std::string>& input);
 
-} // namespace aoc::day12
\ No newline at end of file
+} // namespace aoc::day12
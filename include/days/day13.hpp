@@ -14,13 +14,60 @@
  *         with a maximum of 100 presses per button.
  * Part 2: The prize coordinates are actually 10,000,000,000,000 higher in both X and Y. 
  *         There is no limit on button presses.
+ *
+ * ALGORITHMIC APPROACH:
+ * Machines are parsed into structure-of-arrays columns and solved in blocks
+ * with Cramer's rule. All products are 128-bit, so large prize offsets and
+ * synthetic coordinates cannot overflow. When the determinant is zero (the
+ * buttons move along the same line), the system reduces to a * u + b * v = w
+ * and the cheapest non-negative solution is found with the extended gcd: the
+ * cost 3a + b is linear along the solution lattice, so the optimum sits at
+ * one end of the feasible range.
  */
 
+#include "utils/math_utils.hpp"
+
+#include <cstdint>
+#include <limits>
 #include <string>
 #include <vector>
 
 namespace aoc::day13 {
 
+/// Press limit meaning "no limit"
+inline constexpr std::int64_t kUnlimitedPresses = std::numeric_limits<std::int64_t>::max();
+
+/**
+ * @brief Claw machines stored column-wise
+ */
+struct MachineColumns {
+    std::vector<std::int64_t> ax, ay; ///< Button A movement
+    std::vector<std::int64_t> bx, by; ///< Button B movement
+    std::vector<std::int64_t> px, py; ///< Prize location
+
+    [[nodiscard]] std::size_t size() const { return ax.size(); }
+};
+
+/**
+ * @brief Parses all machines with a single integer scan per line
+ *
+ * Every run of digits (with an optional leading '-') is a value; each machine
+ * contributes six of them in the order AX AY BX BY PX PY.
+ *
+ * @throws std::runtime_error if the value count is not a multiple of six
+ */
+[[nodiscard]] MachineColumns parse_machine_columns(const std::vector<std::string>& input);
+
+/**
+ * @brief Sum of the minimal token costs over all winnable machines
+ * @param machines Parsed machines
+ * @param prize_offset Added to both prize coordinates
+ * @param max_presses Upper bound on presses per button
+ * @return Total tokens (128-bit)
+ */
+[[nodiscard]] aoc::utils::int128 total_min_tokens(const MachineColumns& machines, std::int64_t prize_offset,
+                                                  std::int64_t max_presses = kUnlimitedPresses);
+
 /**
  * @brief Solves part 1 of day 13's puzzle
  * @param input Vector of strings representing the puzzle input
@@ -9,6 +9,11 @@
  * Part 2: [TODO - Beschreibung von Teil 2]
  */
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -48,6 +53,151 @@ std::pair<int, int> simulate_movement(const Robot& robot, int seconds, int width
  */
 long long calculate_safety_factor(const std::vector<std::pair<int, int>>& positions, int width, int height);
 
+/**
+ * @brief Structure-of-arrays robot simulation with incremental stepping
+ *
+ * Coordinates and per-tick steps are kept as separate int32 columns reduced
+ * into [0, width) / [0, height). A tick adds the step and subtracts the size
+ * when the sum overflows, with no modulo. Both that loop and the quadrant
+ * count are branch-free so the compiler vectorizes them across robots.
+ */
+class RobotSwarm {
+public:
+    RobotSwarm(const std::vector<Robot>& robots, int width, int height);
+
+    /**
+     * @brief Moves every robot forward by `seconds` (any non-negative count)
+     */
+    void advance(long long seconds = 1);
+
+    /**
+     * @brief Robots per quadrant (top-left, top-right, bottom-left, bottom-right)
+     */
+    [[nodiscard]] std::array<std::size_t, 4> quadrant_counts() const;
+
+    /**
+     * @brief Product of the four quadrant counts
+     */
+    [[nodiscard]] long long safety_factor() const;
+
+    [[nodiscard]] std::size_t size() const { return xs_.size(); }
+    [[nodiscard]] const std::vector<std::int32_t>& xs() const { return xs_; }
+    [[nodiscard]] const std::vector<std::int32_t>& ys() const { return ys_; }
+    [[nodiscard]] const std::vector<std::int32_t>& x_velocities() const { return vxs_; }
+    [[nodiscard]] const std::vector<std::int32_t>& y_velocities() const { return vys_; }
+    [[nodiscard]] int width() const { return width_; }
+    [[nodiscard]] int height() const { return height_; }
+
+    /**
+     * @brief One wrapped step of a single axis: p = (p + v) mod size
+     * @param positions Coordinates in [0, size)
+     * @param steps Per-robot steps in [0, size)
+     * @param size Axis length
+     */
+    static void step_axis(std::vector<std::int32_t>& positions, const std::vector<std::int32_t>& steps,
+                          std::int32_t size);
+
+private:
+    int width_;
+    int height_;
+    std::vector<std::int32_t> xs_, ys_; ///< Positions in [0, width) x [0, height)
+    std::vector<std::int32_t> vxs_, vys_; ///< Velocities reduced into the same ranges
+    std::vector<std::int32_t> jump_x_, jump_y_; ///< Scratch for multi-second advances
+};
+
+/**
+ * @brief Occupancy bitmap of one frame, one bit per cell, rows padded to 64 bits
+ */
+class OccupancyFrame {
+public:
+    OccupancyFrame(int width, int height);
+
+    /**
+     * @brief Replaces the frame's contents with the swarm's current positions
+     */
+    void load(const RobotSwarm& swarm);
+
+    [[nodiscard]] bool occupied(int x, int y) const;
+    [[nodiscard]] int width() const { return width_; }
+    [[nodiscard]] int height() const { return height_; }
+    [[nodiscard]] std::size_t words_per_row() const { return words_per_row_; }
+
+    /**
+     * @brief Bits of row y; bit i of word w is column w * 64 + i
+     */
+    [[nodiscard]] const std::uint64_t* row(int y) const { return bits_.data() + y * words_per_row_; }
+
+private:
+    int width_;
+    int height_;
+    std::size_t words_per_row_;
+    std::vector<std::uint64_t> bits_;
+};
+
+/**
+ * @brief Scores how structured a frame looks; higher means more picture-like
+ */
+using FrameMetric = std::function<double(const OccupancyFrame&)>;
+
+/**
+ * @brief Length of the longest horizontal run of occupied cells
+ */
+[[nodiscard]] FrameMetric longest_row_run_metric();
+
+/**
+ * @brief Number of occupied cells whose right or lower neighbour is occupied too
+ */
+[[nodiscard]] FrameMetric adjacency_metric();
+
+/**
+ * @brief Entropy deficit of the occupancy over tile x tile blocks
+ *
+ * Returns log2(blocks) minus the Shannon entropy of the occupied-cell
+ * distribution across blocks, so concentrated frames score high. Each block
+ * row slice is counted with a masked popcount over the row's words.
+ *
+ * @throws std::invalid_argument if tile is not positive
+ */
+[[nodiscard]] FrameMetric block_entropy_metric(int tile = 8);
+
+/**
+ * @brief Earliest frame in [0, max_time) whose metric reaches a threshold
+ *
+ * Time ranges are claimed by worker threads in increasing order; once a hit
+ * is known, ranges starting after it are skipped, so the result is the same
+ * as a sequential scan.
+ *
+ * @param robots Robots at time 0
+ * @param width The width of the grid.
+ * @param height The height of the grid.
+ * @param metric Frame score
+ * @param threshold Score that counts as a hit
+ * @param max_time Exclusive upper bound on the time searched
+ * @param thread_count Worker count, 0 = std::thread::hardware_concurrency()
+ * @return First matching time, if any
+ */
+[[nodiscard]] std::optional<int> find_first_frame(const std::vector<Robot>& robots, int width, int height,
+                                                  const FrameMetric& metric, double threshold, int max_time,
+                                                  unsigned thread_count = 0);
+
+/**
+ * @brief Finds the second at which the robots cluster into the picture
+ *
+ * X coordinates repeat every `width` seconds and Y coordinates every
+ * `height` seconds, so the x phase with the smallest spread is found within
+ * `width` steps, the y phase within `height` steps, and the two are combined
+ * with the Chinese remainder theorem. If the periods share a factor and the
+ * phases disagree, the candidates matching the x phase are ranked by their
+ * y spread instead.
+ *
+ * @param robots Robots at time 0
+ * @param width The width of the grid.
+ * @param height The height of the grid.
+ * @return Smallest time in [0, lcm(width, height)) with minimal spread
+ *         (64-bit, since the lcm exceeds int range once width * height >= 2^31)
+ */
+long long find_cluster_time(const std::vector<Robot>& robots, int width, int height);
+
 /**
  * @brief Solves part 1 of day 14's puzzle
  * @param input Vector of strings representing the puzzle input
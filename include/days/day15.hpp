@@ -8,10 +8,26 @@
  * the initial map (walls #, robot @, boxes O, empty .) and movement instructions (< > ^ v).
  * Part 1: Push single-width boxes, calculate sum of GPS coordinates (100*y + x) for all boxes.
  * Part 2: Map is doubled horizontally; boxes become 2-wide ([]), requiring chain-push logic.
+ *
+ * FlatWarehouse is the fast simulator used by both parts: the map is one flat
+ * char buffer, a horizontal push is a single memmove of the pushed run, and a
+ * vertical push walks the affected boxes with a reusable stack and an
+ * epoch-stamped visited array, so a move allocates nothing.
+ *
+ * Very long instruction sequences can be streamed from disk with
+ * simulate_stream(), which applies moves chunk by chunk and reports periodic
+ * checkpoints, so memory stays proportional to the map.
+ *
+ * For what-if planning, FlatWarehouse journals overwritten cells after a
+ * checkpoint and can roll back to it; evaluate_plans() runs many plans from
+ * one shared state on worker threads that each keep a single private copy.
  */
 
+#include <cstdint>
+#include <functional>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace aoc::day15
@@ -96,6 +112,148 @@ namespace aoc::day15
      */
     [[nodiscard]] Warehouse expand_warehouse(const Warehouse& warehouse);
 
+    /**
+     * @brief Warehouse simulator on a flat grid, for single ('O') and wide ('[]') boxes
+     *
+     * While a checkpoint is open, every cell a move overwrites is journaled,
+     * so rolling back costs time proportional to the cells changed since the
+     * checkpoint rather than a copy of the map.
+     */
+    class FlatWarehouse
+    {
+    public:
+        /// Position in the move journal returned by checkpoint()
+        using Mark = std::size_t;
+
+        explicit FlatWarehouse(const Warehouse& warehouse);
+
+        /**
+         * @brief Moves the robot one step, pushing boxes if possible
+         * @return true if the robot moved
+         */
+        bool move(Direction dir);
+
+        /**
+         * @brief Applies every direction character of a plan (others are ignored)
+         */
+        void apply(std::string_view plan);
+
+        /**
+         * @brief GPS sum of all boxes (100*y + x of 'O' or '['), kept up to date per move
+         */
+        [[nodiscard]] long long gps_sum() const;
+
+        [[nodiscard]] Position robot() const;
+        [[nodiscard]] char at(Position pos) const;
+        [[nodiscard]] int width() const { return width_; }
+        [[nodiscard]] int height() const { return height_; }
+
+        /**
+         * @brief Starts (or continues) journaling and returns the current point
+         */
+        [[nodiscard]] Mark checkpoint();
+
+        /**
+         * @brief Undoes every move made after `mark`
+         */
+        void rollback(Mark mark);
+
+        /**
+         * @brief Stops journaling and forgets all checkpoints
+         */
+        void clear_journal();
+
+        /**
+         * @brief Copies the state back into a row-based Warehouse
+         */
+        [[nodiscard]] Warehouse to_warehouse() const;
+
+    private:
+        /// Previous content of one overwritten cell
+        struct JournalEntry
+        {
+            int cell;
+            char previous;
+        };
+
+        /// State before one journaled move
+        struct MoveRecord
+        {
+            std::size_t first_entry;
+            int robot;
+            long long gps;
+        };
+
+        int width_;
+        int height_;
+        std::vector<char> cells_;  ///< Row-major map, including '@'
+        int robot_;                ///< Index of the robot in cells_
+        long long gps_ = 0;
+
+        bool journaling_ = false;
+        std::vector<JournalEntry> journal_;
+        std::vector<MoveRecord> moves_;
+
+        // Scratch for vertical pushes, reused across moves
+        std::vector<std::uint32_t> visited_epoch_;
+        std::uint32_t epoch_ = 0;
+        std::vector<int> stack_;
+        std::vector<int> pushed_;
+        std::vector<char> pushed_tiles_;
+
+        bool push_horizontal(int step);
+        bool push_vertical(int step);
+        void record_move();
+        void journal(int cell);
+    };
+
+    /**
+     * @brief Evaluates many move plans from one shared starting state
+     *
+     * Each worker copies the start state once, then for every plan it claims:
+     * checkpoint, apply, read the GPS sum, roll back.
+     *
+     * @param start Shared starting state (not modified)
+     * @param plans Instruction strings
+     * @param thread_count Worker count, 0 = std::thread::hardware_concurrency()
+     * @return GPS sum after each plan, in plan order
+     */
+    [[nodiscard]] std::vector<long long> evaluate_plans(const FlatWarehouse& start,
+                                                        const std::vector<std::string>& plans,
+                                                        unsigned thread_count = 0);
+
+    /**
+     * @brief Warehouse state after a number of moves of a streamed run
+     */
+    struct WarehouseCheckpoint
+    {
+        std::uint64_t moves_applied; ///< Instructions consumed so far
+        const FlatWarehouse& state;  ///< State after those moves (valid during the callback)
+    };
+
+    /**
+     * @brief Receives checkpoints during simulate_stream()
+     */
+    using CheckpointSink = std::function<void(const WarehouseCheckpoint&)>;
+
+    /**
+     * @brief Simulates a puzzle file whose instructions are read lazily
+     *
+     * The map section is read line by line; the instructions are then applied
+     * as file chunks arrive, so only the map and one chunk are held in memory.
+     *
+     * @param filepath Puzzle file (map + blank line + instructions)
+     * @param wide true to simulate the expanded Part 2 warehouse
+     * @param checkpoint_every Report a checkpoint every this many moves (0 = never)
+     * @param sink Checkpoint receiver; it may copy the state to keep a snapshot
+     * @param chunk_size Bytes read from the file at a time
+     * @return Final warehouse state
+     * @throws std::runtime_error if the file cannot be read or has no map
+     */
+    [[nodiscard]] FlatWarehouse simulate_stream(const std::string& filepath, bool wide,
+                                                std::uint64_t checkpoint_every = 0, const CheckpointSink& sink = {},
+                                                std::size_t chunk_size = 1 << 16);
+
     /**
      * @brief Solves part 1 of day 15's puzzle
      * @param input Vector of strings representing the puzzle input
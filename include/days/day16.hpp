@@ -2,30 +2,147 @@
 
 /**
  * @file day16.hpp
- * @brief Day 16: [TODO - Beschreibung des Puzzles]
+ * @brief Day 16: Reindeer Maze - Weighted Shortest Paths with Turns
  *
- * [TODO - Detaillierte Beschreibung des Puzzles]
- * Part 1: [TODO - Beschreibung von Teil 1]
- * Part 2: [TODO - Beschreibung von Teil 2]
+ * A reindeer starts on S facing East and must reach E. Stepping forward costs
+ * 1 point, rotating 90 degrees in place costs 1000 points.
+ * Part 1: Lowest possible score from S to E.
+ * Part 2: Number of tiles that lie on at least one lowest-score path.
+ *
+ * The search runs over (cell, heading) states on a flat grid. Because the
+ * only edge weights are 1 and 1000, a circular bucket queue (Dial's
+ * algorithm) replaces the binary heap. Part 2 needs no path enumeration: a
+ * second search from E over reversed moves gives the cost-to-go of every
+ * state, and a tile is on a best path exactly when some heading there has
+ * cost-from-S + cost-to-E equal to the best score.
+ *
+ * solve_maze_contracted() runs the same two searches on the corridor graph
+ * from utils/maze_graph.hpp, where only junctions carry states, and expands
+ * the best-path edges back to their corridor tiles; part 2 uses it.
+ *
+ * For very large mazes solve_maze_bidirectional() searches forward from S
+ * and backward from E on two threads at once and stops as soon as the two
+ * frontiers together exceed the best meeting cost, so each side explores
+ * roughly half the distance range.
  */
 
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <string>
 #include <vector>
 
-namespace aoc::day16 {
+namespace aoc::day16
+{
+    /**
+     * @brief Facing of the reindeer; turning moves one step around the cycle
+     */
+    enum class Heading : std::uint8_t { East = 0, South = 1, West = 2, North = 3 };
 
-/**
- * @brief Solves part 1 of day 16's puzzle
- * @param input Vector of strings representing the puzzle input
- * @return String representation of the solution
- */
-std::string solve_part1(const std::vector<std::string>& input);
+    inline constexpr int kHeadingCount = 4;
+    inline constexpr std::uint32_t kStepCost = 1;
+    inline constexpr std::uint32_t kTurnCost = 1000;
 
-/**
- * @brief Solves part 2 of day 16's puzzle
- * @param input Vector of strings representing the puzzle input
- * @return String representation of the solution
- */
-std::string solve_part2(const std::vector<std::string>& input);
+    /// Distance of a state that cannot be reached
+    inline constexpr std::uint32_t kUnreachable = std::numeric_limits<std::uint32_t>::max();
+
+    /**
+     * @brief Maze as a flat grid surrounded by a ring of walls
+     *
+     * The extra ring means neighbour lookups never leave the buffer, so the
+     * search loops need no bounds checks. Cell (x, y) of the input is stored
+     * at (y + 1) * stride + (x + 1).
+     */
+    struct Maze
+    {
+        int stride = 0;            ///< Padded row length (input width + 2)
+        int rows = 0;              ///< Padded row count (input height + 2)
+        std::vector<char> open;    ///< 1 for floor, S and E; 0 for walls
+        int start = 0;             ///< Flat index of S
+        int end = 0;               ///< Flat index of E
+
+        /**
+         * @brief Flat index offset of one step in the given heading
+         */
+        [[nodiscard]] int step(Heading heading) const;
+    };
+
+    /**
+     * @brief Parses the maze grid
+     * @throws std::runtime_error if the maze has no S or no E
+     */
+    [[nodiscard]] Maze parse_maze(const std::vector<std::string>& input);
+
+    /**
+     * @brief Index of a (cell, heading) state in a distance table
+     */
+    [[nodiscard]] constexpr std::size_t state_index(int cell, Heading heading)
+    {
+        return static_cast<std::size_t>(cell) * kHeadingCount + static_cast<std::size_t>(heading);
+    }
+
+    /**
+     * @brief Lowest score from S (facing East) to every state
+     * @return Table indexed by state_index(); kUnreachable where no path exists
+     */
+    [[nodiscard]] std::vector<std::uint32_t> distances_from_start(const Maze& maze);
+
+    /**
+     * @brief Lowest score from every state to E (any final heading)
+     * @return Table indexed by state_index(); kUnreachable where E cannot be reached
+     */
+    [[nodiscard]] std::vector<std::uint32_t> distances_to_end(const Maze& maze);
+
+    /**
+     * @brief Best score and the number of tiles on any best path
+     */
+    struct MazeSolution
+    {
+        std::uint32_t best_score;
+        std::size_t best_path_tiles;
+    };
+
+    /**
+     * @brief Runs the forward and reverse searches and combines them
+     * @throws std::runtime_error if E cannot be reached from S
+     */
+    [[nodiscard]] MazeSolution solve_maze(const Maze& maze);
+
+    /**
+     * @brief Same result as solve_maze(), searching the contracted corridor graph
+     *
+     * Corridor cells are folded into weighted edges (steps + 1000 per forced
+     * bend), so the searches only visit junction states.
+     *
+     * @throws std::runtime_error if E cannot be reached from S
+     */
+    [[nodiscard]] MazeSolution solve_maze_contracted(const Maze& maze);
+
+    /**
+     * @brief Same result as solve_maze(), from two searches running concurrently
+     *
+     * The forward search from S and the backward search from E each run on
+     * their own thread and meet in (cell, heading) states, so a turn made
+     * where they meet is paid by exactly one side. Each side stops once the
+     * sum of both frontier distances exceeds the best meeting cost; the tile
+     * set is then traced from the meeting states through both partial
+     * distance tables.
+     *
+     * @throws std::runtime_error if E cannot be reached from S
+     */
+    [[nodiscard]] MazeSolution solve_maze_bidirectional(const Maze& maze);
+
+    /**
+     * @brief Solves part 1 of day 16's puzzle
+     * @param input Vector of strings representing the puzzle input
+     * @return Lowest score from S to E
+     */
+    std::string solve_part1(const std::vector<std::string>& input);
 
-} // namespace aoc::day16
\ No newline at end of file
+    /**
+     * @brief Solves part 2 of day 16's puzzle
+     * @param input Vector of strings representing the puzzle input
+     * @return Number of tiles on at least one best path
+     */
+    std::string solve_part2(const std::vector<std::string>& input);
+} // namespace aoc::day16
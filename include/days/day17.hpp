@@ -30,14 +30,20 @@
  * - cdv (7): C = A / 2^combo(operand)
  *
  * Part 1: Run the program with given initial register values, collect output
- * Part 2: [TODO - Usually involves finding input that produces specific output]
+ * Part 2: Find the lowest initial value of A for which the program outputs itself
  *
- * Approach: Build a simple VM/interpreter that executes instructions step by step
+ * Approach: Build a simple VM/interpreter that executes instructions step by step.
+ * For Part 2 the program is a single loop that emits one value and shifts A
+ * right by k bits per pass, so the last output depends only on A's top k bits.
+ * A is therefore built k bits at a time from the last output backwards, keeping
+ * every candidate whose run reproduces the output suffix so far; the children of
+ * all candidates at one level are checked in parallel.
  */
 
 #include <string>
 #include <vector>
 #include <cstdint>
+#include <optional>
 
 namespace aoc::day17
 {
@@ -233,6 +239,28 @@ namespace aoc::day17
      */
     std::string runProgram(const std::vector<std::string>& input);
 
+    /**
+     * @brief Find the lowest register A value that makes the program print `target`.
+     *
+     * The program must be one loop of the Part 2 shape: it ends with `jnz 0`,
+     * contains no other jump, outputs exactly one value per pass (a single
+     * `out`), and shifts A right by a literal 1-3 bits exactly once per pass
+     * (`adv k`). Each candidate is checked by running Computer, so
+     * B and C may be computed from A in any way, provided each pass recomputes
+     * them before use rather than carrying them over from the previous pass.
+     *
+     * @param program The program to run
+     * @param target Output sequence to reproduce
+     * @param B Initial value of register B
+     * @param C Initial value of register C
+     * @param thread_count Worker count, 0 = std::thread::hardware_concurrency()
+     * @return Lowest matching A, or std::nullopt if none exists
+     * @throws std::invalid_argument if the program does not have the Part 2 shape
+     *         or the answer could not fit in 63 bits
+     */
+    std::optional<int64_t> findRegisterA(const Program& program, const std::vector<int>& target, int64_t B, int64_t C,
+                                         unsigned thread_count = 0);
+
     /**
      * @brief Solves part 1 of day 17's puzzle
      * @param input Vector of strings representing the puzzle input
@@ -243,14 +271,8 @@ namespace aoc::day17
     /**
      * @brief Solves part 2 of day 17's puzzle
      * @param input Vector of strings representing the puzzle input
-     * @return String representation of the solution
-     *
-     * NOTE: Part 2 typically involves finding an input value (for register A)
-     * that causes the program to output a specific sequence (often the program
-     * itself). This may require:
-     *   - Understanding the program's behavior
-     *   - Working backwards from desired output
-     *   - Bit manipulation insights
+     * @return Lowest value of register A for which the program outputs itself
+     * @throws std::runtime_error if no such value exists
      */
     std::string solve_part2(const std::vector<std::string>& input);
 } // namespace aoc::day17
@@ -5,10 +5,15 @@
  * @brief Utilities for reading puzzle input files
  *
  * Provides functions to read input files either as a vector of lines
- * or as a single raw string.
+ * or as a single raw string, a read-only memory mapping for inputs
+ * too large to copy into memory, and a chunked reader for inputs that
+ * should be consumed as a stream.
  */
 
+#include <cstddef>
+#include <fstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace aoc::utils {
@@ -36,4 +41,77 @@ namespace aoc::utils {
  */
 [[nodiscard]] std::string read_input_raw(const std::string& filepath);
 
+/**
+ * @brief Read-only memory mapping of an input file
+ *
+ * The file content is exposed as a std::string_view without being copied,
+ * so it can be scanned from both ends while the operating system pages it
+ * in on demand. The mapping is released when the object is destroyed.
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Maps the whole file into memory
+     *
+     * @param filepath Path to the input file
+     * @throws std::runtime_error if the file cannot be opened or mapped
+     */
+    explicit MappedFile(const std::string& filepath);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Returns the mapped file content (empty for an empty file)
+     */
+    [[nodiscard]] std::string_view view() const;
+
+private:
+    void* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+/**
+ * @brief Sequential file reader with a fixed-size buffer
+ *
+ * Lines can be taken off the front (for headers such as a map section) and
+ * the rest consumed chunk by chunk, so memory use is bounded by the chunk
+ * size regardless of the file size.
+ */
+class ChunkedFileReader {
+public:
+    /**
+     * @brief Opens the file for streaming
+     *
+     * @param filepath Path to the input file
+     * @param chunk_size Bytes read from the file at a time
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    explicit ChunkedFileReader(const std::string& filepath, std::size_t chunk_size = 1 << 16);
+
+    /**
+     * @brief Reads the next line without its trailing newline
+     *
+     * @param line Receives the line
+     * @return false once the file is exhausted
+     */
+    bool read_line(std::string& line);
+
+    /**
+     * @brief Returns the next block of unread bytes (empty at end of file)
+     *
+     * The view stays valid until the next call on this reader.
+     */
+    [[nodiscard]] std::string_view next_chunk();
+
+private:
+    std::ifstream file_;
+    std::string buffer_;
+    std::size_t begin_ = 0; ///< First unread byte in buffer_
+    std::size_t end_ = 0;   ///< One past the last valid byte in buffer_
+
+    bool refill();
+};
+
 } // namespace aoc::utils
\ No newline at end of file
@@ -10,10 +10,24 @@
 
 #include <algorithm>
 #include <numeric>
+#include <string>
 #include <vector>
 
 namespace aoc::utils {
 
+/**
+ * @brief Signed 128-bit integer for exact intermediates (GCC/Clang extension)
+ */
+__extension__ typedef __int128 int128;
+
+/**
+ * @brief Converts a 128-bit integer to its decimal representation
+ *
+ * @param value The value to convert
+ * @return Decimal string, with a leading '-' for negative values
+ */
+[[nodiscard]] std::string to_string(int128 value);
+
 /**
  * @brief Calculates the greatest common divisor of two numbers
  *
@@ -0,0 +1,83 @@
+#pragma once
+
+/**
+ * @file maze_graph.hpp
+ * @brief Corridor contraction for grid mazes
+ *
+ * Most open cells of a maze are corridor cells with exactly two open
+ * neighbours. contract_maze() keeps only the decision points (junctions,
+ * dead ends and caller-chosen cells such as start and end) as nodes and
+ * replaces each corridor between two of them by a directed edge that
+ * records its length, the 90-degree turns it forces, and the tiles it
+ * covers, so searches run on a much smaller graph and can still expand
+ * their result back to grid tiles.
+ *
+ * Headings are numbered 0 = East, 1 = South, 2 = West, 3 = North; turning
+ * right adds 1 modulo 4.
+ */
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace aoc::utils {
+
+/**
+ * @brief One direction of travel along a contracted corridor
+ */
+struct MazeEdge {
+    int from;                ///< Node the corridor leaves
+    int to;                  ///< Node the corridor reaches
+    int exit_heading;        ///< Heading when stepping out of `from`
+    int entry_heading;       ///< Heading when stepping onto `to`
+    int steps;               ///< Cells moved, including the step onto `to`
+    int turns;               ///< 90-degree turns forced by bends in the corridor
+    std::size_t tile_begin;  ///< First corridor tile in MazeGraph::tiles
+    std::size_t tile_end;    ///< One past the last corridor tile
+};
+
+/**
+ * @brief Junction cell of a contracted maze
+ */
+struct MazeNode {
+    int cell;                          ///< Flat index of the cell
+    std::array<int, 4> out_edge;       ///< Edge leaving in each heading, -1 if none
+    std::array<int, 4> in_edge;        ///< Edge arriving with each heading, -1 if none
+};
+
+/**
+ * @brief Maze with corridors contracted into weighted edges
+ */
+struct MazeGraph {
+    std::vector<MazeNode> nodes;
+    std::vector<MazeEdge> edges;
+    std::vector<int> tiles;        ///< Corridor cells of all edges, in walking order
+    std::vector<int> node_of_cell; ///< Node id per flat cell, -1 for non-nodes
+
+    /**
+     * @brief Corridor cells strictly between the two end nodes of an edge
+     */
+    [[nodiscard]] std::span<const int> edge_tiles(const MazeEdge& edge) const {
+        return std::span<const int>(tiles).subspan(edge.tile_begin, edge.tile_end - edge.tile_begin);
+    }
+};
+
+/**
+ * @brief Contracts every corridor of a maze into weighted edges
+ *
+ * Every open cell whose open-neighbour count is not two becomes a node, as
+ * does every cell in `keep`. A corridor is walked once from each end, so each
+ * edge has a twin running the opposite way with the same tiles. Closed loops
+ * of corridor cells that touch no node are unreachable and left out.
+ *
+ * @param open Row-major mask, non-zero for walkable cells
+ * @param width Row length of the mask
+ * @param keep Flat cells that must stay nodes even inside a corridor
+ * @return The contracted graph
+ * @throws std::invalid_argument if the mask is not a whole number of rows
+ *         or a kept cell is outside it or not walkable
+ */
+[[nodiscard]] MazeGraph contract_maze(std::span<const char> open, int width, std::span<const int> keep = {});
+
+} // namespace aoc::utils
@@ -14,6 +14,7 @@
 #include <vector>
 #include <sstream>
 #include <cmath>
+#include <unordered_set>
 
 namespace aoc::day07
 {
@@ -120,6 +121,143 @@ namespace aoc::day07
         return false;
     }
 
+    // ============================================================================
+    // MEET-IN-THE-MIDDLE SOLVER
+    // ============================================================================
+
+    /**
+     * @brief Operand count above which the meet-in-the-middle solver is used
+     *
+     * Below this the pruned right-to-left recursion is faster, because it needs
+     * no allocations and usually dies out after a few operands.
+     */
+    constexpr std::size_t kMeetInTheMiddleThreshold = 12;
+
+    /**
+     * @brief Returns 10^digits(operand), the factor used by concatenation
+     */
+    [[nodiscard]] std::int64_t concat_multiplier(std::int64_t operand)
+    {
+        std::int64_t multiplier = 10;
+        while (multiplier <= operand)
+        {
+            multiplier *= 10;
+        }
+        return multiplier;
+    }
+
+    /**
+     * @brief Sorts and deduplicates one layer of reachable values
+     */
+    void dedupe_layer(std::vector<std::int64_t>& layer)
+    {
+        std::ranges::sort(layer);
+        const auto [first, last] = std::ranges::unique(layer);
+        layer.erase(first, last);
+    }
+
+    bool is_valid_equation_meet_in_the_middle(const Equation& equation, bool allow_concat)
+    {
+        const auto& operands = equation.operands;
+        const std::int64_t target = equation.test_value;
+        if (operands.empty())
+        {
+            return false;
+        }
+
+        const std::size_t split = (operands.size() + 1) / 2;
+
+        // Forward half: every value reachable from operands[0..split) evaluated
+        // left to right. All operators are non-decreasing for positive operands,
+        // so anything above the target can be dropped immediately.
+        std::vector<std::int64_t> forward{operands[0]};
+        std::vector<std::int64_t> next;
+        for (std::size_t i = 1; i < split; ++i)
+        {
+            const std::int64_t operand = operands[i];
+            const std::int64_t multiplier = allow_concat ? concat_multiplier(operand) : 0;
+            next.clear();
+            for (const std::int64_t value : forward)
+            {
+                if (value <= target - operand)
+                {
+                    next.push_back(value + operand);
+                }
+                if (value <= target / operand)
+                {
+                    next.push_back(value * operand);
+                }
+                if (allow_concat && value <= (target - operand) / multiplier)
+                {
+                    next.push_back(value * multiplier + operand);
+                }
+            }
+            dedupe_layer(next);
+            std::swap(forward, next);
+            if (forward.empty())
+            {
+                return false;
+            }
+        }
+
+        // Backward half: undo operands[split..n) from the target with the same
+        // reverse operators as is_valid_equation, collecting every value the
+        // forward half would have to produce.
+        std::vector<std::int64_t> backward{target};
+        for (std::size_t i = operands.size() - 1; i >= split; --i)
+        {
+            const std::int64_t operand = operands[i];
+            const std::int64_t multiplier = allow_concat ? concat_multiplier(operand) : 0;
+            next.clear();
+            for (const std::int64_t value : backward)
+            {
+                if (value % operand == 0)
+                {
+                    next.push_back(value / operand);
+                }
+                if (allow_concat && value >= operand && (value - operand) % multiplier == 0)
+                {
+                    next.push_back((value - operand) / multiplier);
+                }
+                if (value >= operand)
+                {
+                    next.push_back(value - operand);
+                }
+            }
+            dedupe_layer(next);
+            std::swap(backward, next);
+            if (backward.empty())
+            {
+                return false;
+            }
+        }
+
+        // Join: the equation holds if both halves meet in a common value.
+        const std::unordered_set<std::int64_t> reachable(forward.begin(), forward.end());
+        return std::ranges::any_of(backward, [&](std::int64_t value)
+        {
+            return reachable.contains(value);
+        });
+    }
+
+    /**
+     * @brief Picks the solver for an equation based on its operand count
+     */
+    [[nodiscard]] bool is_solvable(const Equation& equation, bool allow_concat)
+    {
+        const auto& operands = equation.operands;
+        if (operands.empty())
+        {
+            return false;
+        }
+        if (operands.size() > kMeetInTheMiddleThreshold)
+        {
+            return is_valid_equation_meet_in_the_middle(equation, allow_concat);
+        }
+        return is_valid_equation(equation.test_value, operands, static_cast<int>(operands.size() - 1),
+                                 allow_concat);
+    }
+
     // ============================================================================
     // MAIN SOLVING FUNCTIONS
     // ============================================================================
@@ -131,12 +269,11 @@ namespace aoc::day07
          */
         auto equation_objects = parse_input(input);
         int64_t sum = 0;
-        for (const auto& [test_value, operands] : equation_objects)
+        for (const auto& equation : equation_objects)
         {
-            if (!operands.empty() && is_valid_equation(test_value, operands, static_cast<int>(operands.size() - 1),
-                                                       false))
+            if (is_solvable(equation, false))
             {
-                sum += test_value;
+                sum += equation.test_value;
             }
         }
         return std::to_string(sum);
@@ -149,12 +286,11 @@ namespace aoc::day07
          */
         auto equation_objects = parse_input(input);
         int64_t sum = 0;
-        for (const auto& [test_value, operands] : equation_objects)
+        for (const auto& equation : equation_objects)
         {
-            if (!operands.empty() && is_valid_equation(test_value, operands, static_cast<int>(operands.size() - 1),
-                                                       true))
+            if (is_solvable(equation, true))
             {
-                sum += test_value;
+                sum += equation.test_value;
             }
         }
         return std::to_string(sum);
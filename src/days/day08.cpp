@@ -3,16 +3,37 @@
  * @brief Implementation of Day 8: Resonant Collinearity
  *
  * See day08.hpp for detailed puzzle description and algorithmic strategy.
+ *
+ * OPTIMIZATION: Antinodes are written straight into a width x height bitmap
+ * (one bit per cell, packed into 64-bit words) and counted with popcount.
+ * No per-pair vectors are allocated and no std::set is maintained, so the cost
+ * is one bit store per generated antinode.
+ *
+ * SPARSE MODE: For coordinate-list maps that are far too large for a bitmap,
+ * antenna pairs are spread over worker threads and antinodes are deduplicated
+ * in a sharded flat hash set. Each worker batches keys per shard and only takes
+ * a shard lock to flush a full batch.
  */
 
 #include "days/day08.hpp"
 
-#include <set>
+#include "utils/math_utils.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <ranges>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
-#include <ranges>
-#include <cctype>
 
 namespace aoc::day08
 {
@@ -91,77 +112,124 @@ namespace aoc::day08
     }
 
     /**
-     * @brief Calculate antinode positions for a pair of antennas (Part 1)
+     * @brief Bit-packed set of grid cells holding an antinode
+     *
+     * Row-major, one bit per cell. Setting a bit twice is harmless, so
+     * duplicates from different antenna pairs are absorbed for free.
+     */
+    class AntinodeBitmap
+    {
+    private:
+        std::vector<std::uint64_t> words_;
+        int width_;
+        int height_;
+
+    public:
+        AntinodeBitmap(const int width, const int height)
+            : words_((static_cast<std::size_t>(width) * height + 63) / 64, 0), width_(width), height_(height)
+        {
+        }
+
+        [[nodiscard]] bool in_bounds(const int x, const int y) const
+        {
+            return is_in_bounds(x, y, width_, height_);
+        }
+
+        void set(const int x, const int y)
+        {
+            const auto index = static_cast<std::size_t>(y) * width_ + x;
+            words_[index / 64] |= std::uint64_t{1} << (index % 64);
+        }
+
+        [[nodiscard]] long long count() const
+        {
+            long long total = 0;
+            for (const auto word : words_)
+            {
+                total += std::popcount(word);
+            }
+            return total;
+        }
+    };
+
+    /**
+     * @brief Mark the two antinodes of an antenna pair (Part 1)
      * @param a First antenna position
      * @param b Second antenna position
-     * @param width Grid width for bounds checking
-     * @param height Grid height for bounds checking
-     * @return Vector of valid antinode positions (0, 1, or 2 positions)
+     * @param bitmap Antinode bitmap to write into
      *
-     * HINT: Calculate the delta vector: dx = b.x - a.x, dy = b.y - a.y
-     * HINT: Antinode 1 is at (a.x - dx, a.y - dy) - opposite direction from a
-     * HINT: Antinode 2 is at (b.x + dx, b.y + dy) - same direction past b
-     * HINT: Only include positions that are within bounds
+     * Antinodes lie at a - delta and b + delta where delta = b - a.
+     * Positions outside the map are dropped.
      */
-    [[nodiscard]] std::vector<Position> calculate_antinodes_part1(
-        const Position& a, const Position& b, const int width, const int height)
+    void mark_antinodes_part1(const Position& a, const Position& b, AntinodeBitmap& bitmap)
     {
         const auto dx = b.x - a.x;
         const auto dy = b.y - a.y;
-        const auto ax = a.x - dx;
-        const auto ay = a.y - dy;
-        const auto bx = b.x + dx;
-        const auto by = b.y + dy;
-        std::vector<Position> antinodes{{ax, ay}, {bx, by}};
-        std::erase_if(antinodes, [&](const auto& p)
-        {
-            return !is_in_bounds(p.x, p.y, width, height);
-        });
-        return antinodes;
+        if (bitmap.in_bounds(a.x - dx, a.y - dy)) bitmap.set(a.x - dx, a.y - dy);
+        if (bitmap.in_bounds(b.x + dx, b.y + dy)) bitmap.set(b.x + dx, b.y + dy);
     }
 
     /**
-     * @brief Calculate all antinode positions on the line through two antennas (Part 2)
+     * @brief Mark every antinode on the line through two antennas (Part 2)
      * @param a First antenna position
      * @param b Second antenna position
-     * @param width Grid width for bounds checking
-     * @param height Grid height for bounds checking
-     * @return Vector of all valid antinode positions on the line
+     * @param bitmap Antinode bitmap to write into
      *
-     * HINT: Calculate the delta vector: dx = b.x - a.x, dy = b.y - a.y
-     * HINT: Start from position a and go in direction -delta until out of bounds
-     * HINT: Start from position b and go in direction +delta until out of bounds
-     * HINT: Use a while loop to extend the line in both directions
-     * HINT: All positions on the line (including a and b) are antinodes
+     * Walks the line through a and b in both directions with the smallest
+     * lattice step, delta / gcd(|dx|, |dy|), until leaving the map, so every
+     * grid cell exactly in line with the pair is marked (matching
+     * count_antinodes_sparse). Both antennas are antinodes themselves.
      */
-    [[nodiscard]] std::vector<Position> calculate_antinodes_part2(
-        const Position& a, const Position& b, const int width, const int height)
+    void mark_antinodes_part2(const Position& a, const Position& b, AntinodeBitmap& bitmap)
     {
-        std::vector<Position> antinodes{};
-        antinodes.push_back(a);
-        antinodes.push_back(b);
-
         const auto dx = b.x - a.x;
         const auto dy = b.y - a.y;
+        const auto g = static_cast<int>(aoc::utils::gcd(std::abs(dx), std::abs(dy)));
+        if (g == 0) return;
+        const auto sx = dx / g;
+        const auto sy = dy / g;
 
-        // Extend in negative direction from a
-        Position position{a.x - dx, a.y - dy};
-        while (is_in_bounds(position.x, position.y, width, height))
+        for (Position p = a; bitmap.in_bounds(p.x, p.y); p.x -= sx, p.y -= sy)
         {
-            antinodes.push_back(position);
-            position.x -= dx;
-            position.y -= dy;
+            bitmap.set(p.x, p.y);
         }
-        // Extend in positive direction from b
-        position = {b.x + dx, b.y + dy};
-        while (is_in_bounds(position.x, position.y, width, height))
+        for (Position p{a.x + sx, a.y + sy}; bitmap.in_bounds(p.x, p.y); p.x += sx, p.y += sy)
+        {
+            bitmap.set(p.x, p.y);
+        }
+    }
+
+    /**
+     * @brief Run a pair marker over every same-frequency antenna pair
+     * @param input The antenna map
+     * @param mark Pair marker (mark_antinodes_part1 or mark_antinodes_part2)
+     * @return Number of distinct antinode cells
+     *
+     * Width is the row length and height the number of rows, so non-square
+     * maps are bounded correctly.
+     */
+    template <typename Marker>
+    [[nodiscard]] long long count_antinodes(const std::vector<std::string>& input, Marker mark)
+    {
+        if (input.empty() || input[0].empty()) return 0;
+
+        const int width = static_cast<int>(input[0].size());
+        const int height = static_cast<int>(input.size());
+        AntinodeBitmap bitmap(width, height);
+
+        const auto groups = parse_antennas(input);
+        for (const auto& positions : groups | std::views::values)
         {
-            antinodes.push_back(position);
-            position.x += dx;
-            position.y += dy;
+            for (size_t i = 0; i + 1 < positions.size(); ++i)
+            {
+                for (size_t j = i + 1; j < positions.size(); ++j)
+                {
+                    mark(positions[i], positions[j], bitmap);
+                }
+            }
         }
 
-        return antinodes;
+        return bitmap.count();
     }
 
     // ============================================================================
@@ -170,42 +238,13 @@ namespace aoc::day08
 
     std::string solve_part1(const std::vector<std::string>& input)
     {
-        // TODO: Implement Part 1 solution
-        //
         // Algorithm outline:
-        // 1. Get grid dimensions (width, height)
-        // 2. Parse antennas into frequency groups
-        // 3. Create an empty set for unique antinode positions
-        // 4. For each frequency with 2+ antennas:
-        //    a. For each unique pair of antennas (i, j where j > i):
-        //       - Calculate antinodes using calculate_antinodes_part1()
-        //       - Add valid antinodes to the set
-        // 5. Return the size of the antinode set as a string
-        //
-        // HINT: Use nested loops for pair generation:
-        //   for (size_t i = 0; i < positions.size(); ++i)
-        //     for (size_t j = i + 1; j < positions.size(); ++j)
-
-        const int width = static_cast<int>(input.size());
-        const int height = static_cast<int>(input[0].size());
-        auto groups = parse_antennas(input);
-        std::set<Position> unique_antennas;
-        for (auto position : groups | std::views::values)
-        {
-            if (position.size() > 1)
-            {
-                for (size_t i = 0; i < position.size() - 1; ++i)
-                {
-                    for (size_t j = i + 1; j < position.size(); ++j)
-                    {
-                        auto antinodes = calculate_antinodes_part1(position[i], position[j], width, height);
-                        unique_antennas.insert_range(antinodes);
-                    }
-                }
-            }
-        }
+        // 1. Parse antennas into frequency groups
+        // 2. For each unique pair of same-frequency antennas, set the bits of
+        //    its two in-bounds antinodes
+        // 3. Popcount the bitmap
 
-        return std::to_string(unique_antennas.size());
+        return std::to_string(count_antinodes(input, mark_antinodes_part1));
     }
 
     // ============================================================================
@@ -214,41 +253,271 @@ namespace aoc::day08
 
     std::string solve_part2(const std::vector<std::string>& input)
     {
-        // TODO: Implement Part 2 solution
-        //
-        // Algorithm outline:
-        // 1. Get grid dimensions (width, height)
-        // 2. Parse antennas into frequency groups
-        // 3. Create an empty set for unique antinode positions
-        // 4. For each frequency with 2+ antennas:
-        //    a. For each unique pair of antennas (i, j where j > i):
-        //       - Calculate all line positions using calculate_antinodes_part2()
-        //       - Add all valid positions to the set
-        // 5. Return the size of the antinode set as a string
-        //
-        // HINT: The algorithm structure is similar to Part 1
-        // HINT: The difference is in how antinodes are calculated (all line positions)
-        // HINT: Antennas themselves will be included as antinodes
-
-        const int width = static_cast<int>(input.size());
-        const int height = static_cast<int>(input[0].size());
-        auto groups = parse_antennas(input);
-        std::set<Position> unique_antennas;
-        for (auto position : groups | std::views::values)
-        {
-            if (position.size() > 1)
+        // Same structure as Part 1, but every pair marks its whole line
+        // (antennas included) instead of two points.
+
+        return std::to_string(count_antinodes(input, mark_antinodes_part2));
+    }
+
+    // ============================================================================
+    // SPARSE MODE
+    // ============================================================================
+
+    /**
+     * @brief Open-addressing hash set of 64-bit cell keys
+     *
+     * Linear probing over a power-of-two table, grown at 50% load. Slots hold
+     * key + 1 so that zero can mark an empty slot.
+     */
+    class FlatCellSet
+    {
+    private:
+        std::vector<std::uint64_t> slots_;
+        std::size_t size_ = 0;
+
+        [[nodiscard]] static std::uint64_t mix(std::uint64_t key)
+        {
+            key += 0x9e3779b97f4a7c15ULL;
+            key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+            return key ^ (key >> 31);
+        }
+
+        void place(const std::uint64_t stored)
+        {
+            const std::size_t mask = slots_.size() - 1;
+            std::size_t index = mix(stored) & mask;
+            while (slots_[index] != 0)
+            {
+                index = (index + 1) & mask;
+            }
+            slots_[index] = stored;
+        }
+
+        void grow()
+        {
+            std::vector<std::uint64_t> old = std::move(slots_);
+            slots_.assign(old.empty() ? 64 : old.size() * 2, 0);
+            for (const auto stored : old)
+            {
+                if (stored != 0) place(stored);
+            }
+        }
+
+    public:
+        [[nodiscard]] static unsigned shard_of(const std::uint64_t key, const unsigned shard_bits)
+        {
+            return static_cast<unsigned>(mix(key + 1) >> (64 - shard_bits));
+        }
+
+        void insert(const std::uint64_t key)
+        {
+            if ((size_ + 1) * 2 > slots_.size()) grow();
+
+            const std::uint64_t stored = key + 1;
+            const std::size_t mask = slots_.size() - 1;
+            std::size_t index = mix(stored) & mask;
+            while (slots_[index] != 0)
+            {
+                if (slots_[index] == stored) return;
+                index = (index + 1) & mask;
+            }
+            slots_[index] = stored;
+            ++size_;
+        }
+
+        [[nodiscard]] std::size_t size() const
+        {
+            return size_;
+        }
+    };
+
+    /**
+     * @brief Antinode set split into independently locked shards
+     *
+     * Workers never insert single keys: they collect keys per shard in a local
+     * ShardedCellSet::Batch and flush a whole batch under one lock.
+     */
+    class ShardedCellSet
+    {
+    public:
+        static constexpr unsigned kShardBits = 6;
+        static constexpr unsigned kShardCount = 1u << kShardBits;
+        static constexpr std::size_t kBatchSize = 1024;
+
+        class Batch
+        {
+        private:
+            ShardedCellSet& owner_;
+            std::array<std::vector<std::uint64_t>, kShardCount> pending_;
+
+        public:
+            explicit Batch(ShardedCellSet& owner) : owner_(owner)
+            {
+            }
+
+            ~Batch()
+            {
+                for (unsigned shard = 0; shard < kShardCount; ++shard)
+                {
+                    owner_.flush(shard, pending_[shard]);
+                }
+            }
+
+            Batch(const Batch&) = delete;
+            Batch& operator=(const Batch&) = delete;
+
+            void add(const std::uint64_t key)
+            {
+                const unsigned shard = FlatCellSet::shard_of(key, kShardBits);
+                auto& pending = pending_[shard];
+                pending.push_back(key);
+                if (pending.size() >= kBatchSize) owner_.flush(shard, pending);
+            }
+        };
+
+        [[nodiscard]] std::size_t size() const
+        {
+            std::size_t total = 0;
+            for (const auto& shard : shards_)
+            {
+                total += shard.cells.size();
+            }
+            return total;
+        }
+
+    private:
+        struct Shard
+        {
+            std::mutex mutex;
+            FlatCellSet cells;
+        };
+
+        std::array<Shard, kShardCount> shards_;
+
+        void flush(const unsigned shard, std::vector<std::uint64_t>& pending)
+        {
+            if (pending.empty()) return;
+            std::lock_guard lock(shards_[shard].mutex);
+            for (const auto key : pending)
             {
-                for (size_t i = 0; i < position.size() - 1; ++i)
+                shards_[shard].cells.insert(key);
+            }
+            pending.clear();
+        }
+    };
+
+    SparseMap parse_sparse_map(const std::vector<std::string>& input)
+    {
+        if (input.empty())
+            throw std::runtime_error("Sparse map is empty");
+
+        SparseMap map{};
+        std::istringstream header(input[0]);
+        if (!(header >> map.width >> map.height) || map.width <= 0 || map.height <= 0)
+            throw std::runtime_error("Sparse map header must be 'width height'");
+
+        for (size_t i = 1; i < input.size(); ++i)
+        {
+            if (input[i].empty()) continue;
+            std::istringstream line(input[i]);
+            Antenna antenna{};
+            if (!(line >> antenna.frequency >> antenna.x >> antenna.y))
+                throw std::runtime_error("Malformed antenna line: " + input[i]);
+            map.antennas.push_back(antenna);
+        }
+        return map;
+    }
+
+    std::size_t count_antinodes_sparse(const SparseMap& map, const bool resonant, unsigned thread_count)
+    {
+        const std::int64_t width = map.width;
+        const std::int64_t height = map.height;
+        auto in_bounds = [&](const std::int64_t x, const std::int64_t y)
+        {
+            return x >= 0 && x < width && y >= 0 && y < height;
+        };
+
+        // Group antennas by frequency
+        std::array<std::vector<Antenna>, 256> by_frequency{};
+        for (const auto& antenna : map.antennas)
+        {
+            by_frequency[static_cast<unsigned char>(antenna.frequency)].push_back(antenna);
+        }
+
+        // One work item per (frequency, first antenna) row of the pair triangle,
+        // so a single busy frequency is still spread over all workers
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> rows;
+        for (std::uint32_t f = 0; f < by_frequency.size(); ++f)
+        {
+            for (std::uint32_t i = 0; i + 1 < by_frequency[f].size(); ++i)
+            {
+                rows.emplace_back(f, i);
+            }
+        }
+
+        ShardedCellSet antinodes;
+        std::atomic<std::size_t> next_row{0};
+        constexpr std::size_t kRowsPerClaim = 16;
+
+        auto worker = [&]
+        {
+            ShardedCellSet::Batch batch(antinodes);
+            auto mark = [&](const std::int64_t x, const std::int64_t y)
+            {
+                batch.add(static_cast<std::uint64_t>(y) * static_cast<std::uint64_t>(width) +
+                          static_cast<std::uint64_t>(x));
+            };
+
+            for (std::size_t begin = next_row.fetch_add(kRowsPerClaim); begin < rows.size();
+                 begin = next_row.fetch_add(kRowsPerClaim))
+            {
+                const std::size_t end = std::min(rows.size(), begin + kRowsPerClaim);
+                for (std::size_t r = begin; r < end; ++r)
                 {
-                    for (size_t j = i + 1; j < position.size(); ++j)
+                    const auto& group = by_frequency[rows[r].first];
+                    const Antenna& a = group[rows[r].second];
+                    for (std::size_t j = rows[r].second + 1; j < group.size(); ++j)
                     {
-                        auto antinodes = calculate_antinodes_part2(position[i], position[j], width, height);
-                        unique_antennas.insert_range(antinodes);
+                        const Antenna& b = group[j];
+                        const std::int64_t dx = b.x - a.x;
+                        const std::int64_t dy = b.y - a.y;
+
+                        if (!resonant)
+                        {
+                            if (in_bounds(a.x - dx, a.y - dy)) mark(a.x - dx, a.y - dy);
+                            if (in_bounds(b.x + dx, b.y + dy)) mark(b.x + dx, b.y + dy);
+                            continue;
+                        }
+
+                        // Smallest lattice step along the line through a and b
+                        const std::int64_t g = aoc::utils::gcd(std::abs(dx), std::abs(dy));
+                        if (g == 0) continue;
+                        const std::int64_t sx = dx / g;
+                        const std::int64_t sy = dy / g;
+                        for (std::int64_t x = a.x, y = a.y; in_bounds(x, y); x -= sx, y -= sy)
+                        {
+                            mark(x, y);
+                        }
+                        for (std::int64_t x = a.x + sx, y = a.y + sy; in_bounds(x, y); x += sx, y += sy)
+                        {
+                            mark(x, y);
+                        }
                     }
                 }
             }
+        };
+
+        if (thread_count == 0) thread_count = std::max(1u, std::thread::hardware_concurrency());
+        {
+            std::vector<std::jthread> workers;
+            workers.reserve(thread_count);
+            for (unsigned t = 0; t < thread_count; ++t)
+            {
+                workers.emplace_back(worker);
+            }
         }
 
-        return std::to_string(unique_antennas.size());
+        return antinodes.size();
     }
 } // namespace aoc::day08
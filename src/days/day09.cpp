@@ -26,18 +26,17 @@
  * Move individual blocks from the end of the disk to the leftmost free space.
  * Continue until there are no gaps between file blocks.
  *
- * Algorithm (Two-Pointer Approach):
- * 1. Parse the disk map into a flat array of blocks
- * 2. Initialize left pointer at start (looking for free space)
- * 3. Initialize right pointer at end (looking for file blocks)
- * 4. While left < right:
- *    a. Move left pointer to next free space
- *    b. Move right pointer to previous file block
- *    c. If both found and left < right, swap them
- * 5. Calculate checksum
+ * Algorithm (Two-Pointer Approach over spans):
+ * 1. Left cursor walks the disk map digits, tracking the current block position
+ * 2. Right cursor sits on the last file digit with a count of blocks still unmoved
+ * 3. A file digit under the left cursor stays in place
+ * 4. A free digit is filled with blocks taken from the right cursor's file,
+ *    stepping the right cursor to the previous file when it runs dry
+ * 5. Every run of k blocks of file id at position p adds
+ *    id * (p * k + k * (k - 1) / 2) to the checksum
  *
- * Time Complexity: O(n) where n is the total number of blocks
- * Space Complexity: O(n) for the disk array
+ * Time Complexity: O(m) where m is the number of digits in the disk map
+ * Space Complexity: O(1) beyond the disk map (no block expansion)
  *
  * ============================================================================
  * PART 2: WHOLE-FILE COMPACTION
@@ -56,11 +55,31 @@
  *    b. If found, move the file there and update free spans
  * 3. Calculate checksum
  *
- * Time Complexity: O(f * s) where f = number of files, s = number of free spans
- *                  (Can be optimized with better data structures)
+ * Free spans are kept in a FreeSpanIndex: one min-heap of start positions per
+ * span length 1-9. A file of length L takes the leftmost of the heap tops for
+ * lengths L..9; the unused remainder is pushed into the heap for its new length.
+ * Space freed by a moved file never needs to be indexed, because every file
+ * processed later starts to the left of it.
+ *
+ * Time Complexity: O(f log s) where f = number of files, s = number of free spans
  * Space Complexity: O(n) for tracking spans
  *
  * ============================================================================
+ * STREAMING MODE
+ * ============================================================================
+ *
+ * For disk maps too large to hold as a std::string the file is memory-mapped
+ * and both parts run on the mapping:
+ * - Part 1: compact_blocks_checksum() needs only its two cursors.
+ * - Part 2: compact_files_checksum() replaces the heaps with one forward
+ *   cursor per file length. The leftmost free span that fits a file of length
+ *   L only moves right over time, so each cursor sweeps the map at most once
+ *   (O(9m) total). The cursors are kept ordered by length, and spans behind
+ *   the cursor of the shortest file length still to be placed are erased,
+ *   so only the partially filled spans between that cursor and the length-9
+ *   cursor have to be remembered.
+ *
+ * ============================================================================
  * IMPLEMENTATION TIPS
  * ============================================================================
  *
@@ -83,10 +102,15 @@
 
 #include "days/day09.hpp"
 
+#include "utils/input_handler.hpp"
+
 #include <algorithm>
 #include <cstdint>
 #include <numeric>
+#include <ranges>
+#include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace aoc::day09
@@ -247,114 +271,274 @@ namespace aoc::day09
         }
     }
 
-    // ============================================================================
-    // PART 1 SOLUTION
-    // ============================================================================
-
-    std::string solve_part1(const std::vector<std::string>& input)
+    FreeSpanIndex::FreeSpanIndex(const std::vector<Span>& free_spans)
     {
-        // TODO: Implement Part 1
-        //
-        // STEP-BY-STEP APPROACH:
-        //
-        // 1. Get the disk map from input[0] (it's a single line)
-        //    - Note: input is a vector of strings, but the puzzle input is one line
-        //
-        // 2. Parse the disk map into a vector of blocks
-        //    - Call parse_disk_map() helper function
-        //
-        // 3. Compact the disk using two-pointer technique:
-        //    - left = 0, right = disk.size() - 1
-        //    - while left < right:
-        //      a. Find next free space from left
-        //      b. Find next file block from right
-        //      c. If both found and left < right, swap them
-        //
-        // 4. Calculate and return the checksum
-        //    - Call calculate_checksum() helper function
-        //
-        // DEBUG TIP: For the example "2333133121414131402", the answer is 1928
-        // You can print the disk state after each swap to verify your logic.
+        for (const Span& span : free_spans)
+        {
+            add(span);
+        }
+    }
 
-        // Your implementation here...
-        auto disk = parse_disk_map(input[0]);
-        if (disk.empty()) return "0";
+    std::optional<int> FreeSpanIndex::allocate(int required_length, int max_position)
+    {
+        if (required_length < 0 || required_length > kMaxSpanLength)
+        {
+            throw std::invalid_argument("File length must be between 0 and 9 blocks");
+        }
 
-        int left = 0;
-        int right = static_cast<int>(disk.size()) - 1;
-        while (left < right)
+        // Leftmost candidate among the heaps that can hold the file
+        int best_length = 0;
+        int best_start = max_position;
+        for (int length = std::max(required_length, 1); length <= kMaxSpanLength; ++length)
         {
-            left = find_first_free_space(disk, left);
-            right = find_last_file_block(disk, right);
-            if (left != -1 && right != -1 && left < right)
+            if (!heaps_[length].empty() && heaps_[length].top() < best_start)
             {
-                std::swap(disk[left], disk[right]);
+                best_start = heaps_[length].top();
+                best_length = length;
             }
         }
 
-        return std::to_string(calculate_checksum(disk));
+        if (best_length == 0) return std::nullopt;
+
+        heaps_[best_length].pop();
+        add(Span{best_start + required_length, best_length - required_length, -1});
+        return best_start;
     }
 
-    // ============================================================================
-    // PART 2 SOLUTION
-    // ============================================================================
+    void FreeSpanIndex::add(const Span& span)
+    {
+        if (span.length > kMaxSpanLength)
+        {
+            throw std::invalid_argument("Free span longer than 9 blocks cannot be indexed");
+        }
+        if (span.length > 0)
+        {
+            heaps_[span.length].push(span.start);
+        }
+    }
 
-    std::string solve_part2(const std::vector<std::string>& input)
+    /**
+     * @brief Trims a disk map to its leading run of digits (drops newlines etc.)
+     */
+    [[nodiscard]] std::string_view digits_prefix(std::string_view disk_map)
     {
-        if (input.empty() || input[0].empty()) return "0";
+        const auto digits_end = std::ranges::find_if(disk_map, [](char c) { return c < '0' || c > '9'; });
+        return disk_map.substr(0, static_cast<std::size_t>(digits_end - disk_map.begin()));
+    }
 
-        const std::string& disk_map = input[0];
+    /**
+     * @brief Checksum of `count` blocks of `file_id` starting at `position`
+     */
+    [[nodiscard]] aoc::utils::int128 run_checksum(const std::int64_t file_id, const std::int64_t position,
+                                                  const std::int64_t count)
+    {
+        return aoc::utils::int128{file_id} * (aoc::utils::int128{position} * count + count * (count - 1) / 2);
+    }
 
-        // Parse into file spans and free spans
-        std::vector<Span> file_spans;
-        std::vector<Span> free_spans;
-        parse_into_spans(disk_map, file_spans, free_spans);
+    aoc::utils::int128 compact_blocks_checksum(std::string_view disk_map)
+    {
+        disk_map = digits_prefix(disk_map);
+        if (disk_map.empty()) return 0;
 
-        // Process files in descending order by ID
-        for (int i = static_cast<int>(file_spans.size()) - 1; i >= 0; --i)
-        {
-            Span& file = file_spans[i];
-            int old_start = file.start;
+        auto digit = [&](std::size_t index) { return static_cast<std::int64_t>(disk_map[index] - '0'); };
+
+        aoc::utils::int128 checksum = 0;
+        std::int64_t position = 0;
+
+        // Right cursor: last file digit and how many of its blocks are still unmoved
+        std::size_t right = (disk_map.size() - 1) & ~std::size_t{1};
+        std::int64_t right_remaining = digit(right);
 
-            // Find the leftmost free span that can fit this file
-            int free_idx = find_suitable_free_span(free_spans, file.length, old_start);
+        for (std::size_t left = 0; left <= right; ++left)
+        {
+            if (left % 2 == 0)
+            {
+                // File span stays where it is (possibly partially moved already)
+                const std::int64_t count = left == right ? right_remaining : digit(left);
+                checksum += run_checksum(static_cast<std::int64_t>(left / 2), position, count);
+                position += count;
+                continue;
+            }
 
-            if (free_idx != -1)
+            // Free span: fill it from the right-most file
+            std::int64_t free = digit(left);
+            while (free > 0 && right > left)
             {
-                Span& free_span = free_spans[free_idx];
+                if (right_remaining == 0)
+                {
+                    right -= 2;
+                    right_remaining = right > left ? digit(right) : 0;
+                    continue;
+                }
+                const std::int64_t take = std::min(free, right_remaining);
+                checksum += run_checksum(static_cast<std::int64_t>(right / 2), position, take);
+                position += take;
+                free -= take;
+                right_remaining -= take;
+            }
+        }
 
-                // Move the file to the free span
-                file.start = free_span.start;
+        return checksum;
+    }
 
-                // Update the free span
-                free_span.length -= file.length;
-                free_span.start += file.length;
+    aoc::utils::int128 compact_files_checksum(std::string_view disk_map, std::size_t* peak_partial_spans)
+    {
+        if (peak_partial_spans) *peak_partial_spans = 0;
+        disk_map = digits_prefix(disk_map);
+        if (disk_map.empty()) return 0;
 
-                // If the free span is now empty (exactly filled), remove it
-                if (free_span.length == 0)
+        auto digit = [&](std::size_t index)
+        {
+            return index < disk_map.size() ? static_cast<std::int64_t>(disk_map[index] - '0') : 0;
+        };
+
+        // Free spans that have been partially filled, keyed by digit index
+        std::unordered_map<std::size_t, std::int64_t> remaining;
+        auto free_left = [&](std::size_t index)
+        {
+            const auto it = remaining.find(index);
+            return it != remaining.end() ? it->second : digit(index);
+        };
+
+        // cursors[L]: leftmost free span (odd digit index + block position)
+        // that may still hold L blocks
+        struct Cursor
+        {
+            std::size_t index;
+            std::int64_t position;
+        };
+        std::array<Cursor, 10> cursors{};
+        cursors.fill(Cursor{1, digit(0)});
+
+        // Files of each length still to be processed: the lowest length with
+        // files left owns the lowest cursor that will ever be read again
+        std::array<std::size_t, 10> files_left{};
+        std::int64_t end = 0;
+        for (std::size_t index = 0; index < disk_map.size(); ++index)
+        {
+            end += digit(index);
+            if (index % 2 == 0) ++files_left[static_cast<std::size_t>(digit(index))];
+        }
+        std::size_t forgotten = 1; // Every partially filled span left of this index is erased
+
+        aoc::utils::int128 checksum = 0;
+        std::size_t file = (disk_map.size() - 1) & ~std::size_t{1};
+        if (file + 1 < disk_map.size()) end -= digit(file + 1);
+
+        while (true)
+        {
+            const std::int64_t length = digit(file);
+            const std::int64_t start = end - length;
+            std::int64_t placed = start;
+
+            if (length > 0)
+            {
+                Cursor& cursor = cursors[length];
+                while (cursor.index < file && free_left(cursor.index) < length)
+                {
+                    const std::size_t passed = cursor.index;
+                    cursor.position += digit(passed) + digit(passed + 1);
+                    cursor.index += 2;
+                }
+
+                // A span too small for L-1 blocks is too small for L: keep cursors ordered by length
+                for (std::size_t longer = static_cast<std::size_t>(length) + 1;
+                     longer < cursors.size() && cursors[longer].index < cursors[longer - 1].index; ++longer)
                 {
-                    free_spans.erase(free_spans.begin() + free_idx);
+                    cursors[longer] = cursors[longer - 1];
                 }
 
-                // Add the file's old position as a new free span
-                // Insert in sorted order by position
-                Span old_position{old_start + file.length, file.length, -1};
-                auto insert_pos = std::ranges::find_if(free_spans, [pos = old_position.start](const Span& s)
+                if (cursor.index < file)
                 {
-                    return s.start > pos;
-                });
-                free_spans.insert(insert_pos, old_position);
+                    const std::int64_t left = free_left(cursor.index);
+                    placed = cursor.position + (digit(cursor.index) - left);
+                    remaining[cursor.index] = left - length;
+                    if (peak_partial_spans) *peak_partial_spans = std::max(*peak_partial_spans, remaining.size());
+                }
+
+                // Forget the spans behind the lowest cursor still in use; no cursor reads them again
+                --files_left[static_cast<std::size_t>(length)];
+                const auto lowest = std::ranges::find_if(files_left.begin() + 1, files_left.end(),
+                                                         [](std::size_t count) { return count > 0; });
+                if (lowest != files_left.end())
+                {
+                    const std::size_t frontier = cursors[static_cast<std::size_t>(lowest - files_left.begin())].index;
+                    for (; forgotten < frontier; forgotten += 2)
+                    {
+                        remaining.erase(forgotten);
+                    }
+                }
             }
+
+            checksum += run_checksum(static_cast<std::int64_t>(file / 2), placed, length);
+
+            if (file == 0) break;
+            end = start - digit(file - 1);
+            file -= 2;
         }
 
-        // Calculate checksum from the final file spans
+        return checksum;
+    }
+
+    aoc::utils::int128 stream_part1_checksum(const std::string& filepath)
+    {
+        const aoc::utils::MappedFile mapped(filepath);
+        return compact_blocks_checksum(mapped.view());
+    }
+
+    aoc::utils::int128 stream_part2_checksum(const std::string& filepath)
+    {
+        const aoc::utils::MappedFile mapped(filepath);
+        return compact_files_checksum(mapped.view());
+    }
+
+    [[nodiscard]] long long span_checksum(const Span& file)
+    {
+        const long long start = file.start;
+        const long long length = file.length;
+        return file.file_id * (start * length + length * (length - 1) / 2);
+    }
+
+    // ============================================================================
+    // PART 1 SOLUTION
+    // ============================================================================
+
+    std::string solve_part1(const std::vector<std::string>& input)
+    {
+        if (input.empty()) return "0";
+
+        // Two-pointer compaction over the disk map spans; the block-level
+        // helpers above (parse_disk_map, find_first_free_space, ...) describe the
+        // same process one block at a time.
+        return aoc::utils::to_string(compact_blocks_checksum(input[0]));
+    }
+
+    // ============================================================================
+    // PART 2 SOLUTION
+    // ============================================================================
+
+    std::string solve_part2(const std::vector<std::string>& input)
+    {
+        if (input.empty() || input[0].empty()) return "0";
+
+        const std::string& disk_map = input[0];
+
+        // Parse into file spans and free spans
+        std::vector<Span> file_spans;
+        std::vector<Span> free_spans;
+        parse_into_spans(disk_map, file_spans, free_spans);
+
+        // Process files in descending order by ID, each taking the leftmost
+        // free span that fits
+        FreeSpanIndex index(free_spans);
         int64_t checksum = 0;
-        for (const Span& file : file_spans)
+        for (auto& file : std::views::reverse(file_spans))
         {
-            for (int j = 0; j < file.length; ++j)
+            if (const auto target = index.allocate(file.length, file.start))
             {
-                checksum += static_cast<int64_t>(file.start + j) * file.file_id;
+                file.start = *target;
             }
+            checksum += span_checksum(file);
         }
 
         return std::to_string(checksum);
@@ -9,159 +9,441 @@
  * - Part 1 (Score): Count how many unique 9-height positions are reachable from each trailhead (0).
  * - Part 2 (Rating): Count the total number of distinct hiking trails starting from each trailhead (0).
  * - Goal: Calculate the sum of scores (Part 1) and the sum of ratings (Part 2).
+ *
+ * OPTIMIZATION: Height-layered dynamic programming instead of a DFS per trailhead.
+ * - Cells are bucketed by height on a flat uint8_t grid.
+ * - Layer 9 seeds every 9 with a path count of 1 and a set containing itself.
+ * - Layer h sums the path counts and unions the reachable-9 sets of its
+ *   neighbours in layer h+1.
+ * - Reachable sets are dense bitsets over the 9s when the two live layers fit
+ *   in kDenseBudgetBytes (or the caller's budget), and sorted id lists in a
+ *   flat (CSR) buffer otherwise.
+ *   A cell of height h can only reach 9s within Manhattan distance 9 - h, so
+ *   the sparse lists stay short on arbitrarily large maps.
+ *
+ * TrailIndex stores the same quantities for every cell (plus trail counts
+ * from the 0s upward) and, after an edit, re-runs the per-cell update only on
+ * the cells whose inputs could have changed: the cells that climb into the
+ * edited cell or its old lower neighbours, and the cells reachable from the
+ * edited cell or its old higher neighbours.
  */
 
 #include "days/day10.hpp"
 
-#include <ranges>
-#include <vector>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
 #include <string>
-#include <set>
+#include <vector>
 
 namespace aoc::day10
 {
+    // ============================================================================
+    // TYPES AND CONSTANTS
+    // ============================================================================
+
+    /// Marker for cells that are not part of any trail
+    constexpr std::uint8_t kImpassable = 0xFF;
+
     /**
-     * @brief Recommended helper to check if a coordinate is within grid bounds.
+     * @brief Flat row-major height map with cells bucketed by height
      */
-    bool is_valid(int r, int c, int rows, int cols)
+    struct HeightMap
     {
-        return r >= 0 && c >= 0 && r < rows && c < cols;
+        int rows = 0;
+        int cols = 0;
+        std::vector<std::uint8_t> heights;
+        std::array<std::vector<std::uint32_t>, 10> layers; ///< Cell indices per height
+        std::vector<std::uint32_t> slot;                   ///< Index of a cell within its layer
+    };
+
+    [[nodiscard]] HeightMap build_height_map(const std::vector<std::string>& input)
+    {
+        HeightMap map;
+        map.rows = static_cast<int>(input.size());
+        for (const auto& line : input)
+        {
+            map.cols = std::max(map.cols, static_cast<int>(line.size()));
+        }
+
+        const auto cells = static_cast<std::size_t>(map.rows) * map.cols;
+        map.heights.assign(cells, kImpassable);
+        map.slot.assign(cells, 0);
+        for (int r = 0; r < map.rows; ++r)
+        {
+            const auto& line = input[r];
+            for (int c = 0; c < static_cast<int>(line.size()); ++c)
+            {
+                if (line[c] < '0' || line[c] > '9') continue;
+
+                const auto index = static_cast<std::uint32_t>(r * map.cols + c);
+                const auto height = static_cast<std::uint8_t>(line[c] - '0');
+                map.heights[index] = height;
+                map.slot[index] = static_cast<std::uint32_t>(map.layers[height].size());
+                map.layers[height].push_back(index);
+            }
+        }
+        return map;
     }
 
     /**
-     * @brief Recommended helper for Part 1: Find all unique 9s reachable from a position.
-     * @tip Use a std::set<std::pair<int, int>> to store coordinates of reached 9s to ensure uniqueness.
+     * @brief Calls fn(neighbour) for every orthogonal neighbour one step higher
      */
-    void find_reachable_nines(int r, int c, const std::vector<std::vector<int>>& grid,
-                              std::set<std::pair<int, int>>& found_nines)
+    template <typename Fn>
+    void for_each_uphill(const HeightMap& map, const std::uint32_t index, Fn&& fn)
     {
-        auto current_height = grid[r][c];
+        const int r = static_cast<int>(index) / map.cols;
+        const int c = static_cast<int>(index) % map.cols;
+        const std::uint8_t next = map.heights[index] + 1;
+
+        if (r > 0 && map.heights[index - map.cols] == next) fn(index - map.cols);
+        if (r + 1 < map.rows && map.heights[index + map.cols] == next) fn(index + map.cols);
+        if (c > 0 && map.heights[index - 1] == next) fn(index - 1);
+        if (c + 1 < map.cols && map.heights[index + 1] == next) fn(index + 1);
+    }
+
+    // ============================================================================
+    // LAYERED SWEEP
+    // ============================================================================
 
-        // 1. Base case: If current height is 9, add coordinates to set and return.
-        if (current_height == 9)
+    /**
+     * @brief Part 2 path counts with every 9 seeded as one trail
+     *
+     * The sweeps add each cell's neighbour counts while building its reachable
+     * set, so both parts share a single pass over the neighbours.
+     */
+    [[nodiscard]] std::vector<long long> seed_paths(const HeightMap& map)
+    {
+        std::vector<long long> paths(map.heights.size(), 0);
+        for (const auto index : map.layers[9])
         {
-            found_nines.insert({r, c});
-            return;
+            paths[index] = 1;
         }
+        return paths;
+    }
 
-        // 2. Explore 4 cardinal neighbors (Up, Down, Left, Right).
-        int dr[] = {-1, 1, 0, 0};
-        int dc[] = {0, 0, -1, 1};
+    /**
+     * @brief Layered sweep with one bitset over all 9s per cell of the live layers
+     * @return Sum of trailhead scores; paths receives every cell's trail count
+     */
+    [[nodiscard]] long long sweep_dense(const HeightMap& map, std::vector<long long>& paths)
+    {
+        const auto& nines = map.layers[9];
+        const std::size_t words = (nines.size() + 63) / 64;
 
-        // 3. Move only if neighbor is valid AND neighbor_height == current_height + 1.
-        for (int i = 0; i < 4; ++i)
+        std::vector<std::uint64_t> upper(nines.size() * words, 0);
+        for (std::size_t i = 0; i < nines.size(); ++i)
         {
-            int nr = r + dr[i];
-            int nc = c + dc[i];
+            upper[i * words + i / 64] |= std::uint64_t{1} << (i % 64);
+        }
 
-            if (is_valid(nr, nc, grid.size(), grid[0].size()) && grid[nr][nc] == current_height + 1)
+        std::vector<std::uint64_t> lower;
+        for (int height = 8; height >= 0; --height)
+        {
+            const auto& layer = map.layers[height];
+            lower.assign(layer.size() * words, 0);
+            for (std::size_t i = 0; i < layer.size(); ++i)
             {
-                find_reachable_nines(nr, nc, grid, found_nines);
+                std::uint64_t* bits = &lower[i * words];
+                for_each_uphill(map, layer[i], [&](std::uint32_t next)
+                {
+                    paths[layer[i]] += paths[next];
+                    const std::uint64_t* from = &upper[map.slot[next] * words];
+                    for (std::size_t w = 0; w < words; ++w) bits[w] |= from[w];
+                });
             }
+            std::swap(upper, lower);
+        }
+
+        long long total = 0;
+        for (const auto word : upper)
+        {
+            total += std::popcount(word);
         }
+        return total;
     }
 
     /**
-     * @brief Recommended helper for Part 2: Count all distinct paths to any 9.
-     * @return The number of distinct paths starting from (r, c).
-     * @tip This can be implemented with recursion. Memoization (caching results for a cell)
-     *      could improve performance, though it may not be strictly necessary for this grid size.
+     * @brief Layered sweep with sorted lists of 9 ids per cell, stored back to back
+     * @return Sum of trailhead scores; paths receives every cell's trail count
      */
-    int count_distinct_paths(int r, int c, const std::vector<std::vector<int>>& grid,
-                             std::vector<std::vector<int>>& memo)
+    [[nodiscard]] long long sweep_sparse(const HeightMap& map, std::vector<long long>& paths)
     {
-        if (memo[r][c] != -1)
+        // Layer h+1: ids of cell i live in upper_ids[upper_offsets[i] .. upper_offsets[i + 1])
+        const auto& nines = map.layers[9];
+        std::vector<std::uint32_t> upper_ids(nines.size());
+        std::vector<std::uint32_t> upper_offsets(nines.size() + 1);
+        for (std::uint32_t i = 0; i < nines.size(); ++i)
         {
-            return memo[r][c];
+            upper_ids[i] = i;
+            upper_offsets[i + 1] = i + 1;
         }
-        // TODO: Implement recursive path counting
-        // 1. Base case: If current height is 9, return 1 (one path found).
-        auto current_height = grid[r][c];
 
-        // 1. Base case: If current height is 9, add coordinates to set and return.
-        if (current_height == 9)
+        std::vector<std::uint32_t> lower_ids;
+        std::vector<std::uint32_t> lower_offsets;
+        std::vector<std::uint32_t> scratch;
+        for (int height = 8; height >= 0; --height)
         {
-            return 1;
+            const auto& layer = map.layers[height];
+            lower_ids.clear();
+            lower_offsets.assign(1, 0);
+            for (const auto index : layer)
+            {
+                scratch.clear();
+                for_each_uphill(map, index, [&](std::uint32_t next)
+                {
+                    paths[index] += paths[next];
+                    const auto slot = map.slot[next];
+                    scratch.insert(scratch.end(), upper_ids.begin() + upper_offsets[slot],
+                                   upper_ids.begin() + upper_offsets[slot + 1]);
+                });
+                std::ranges::sort(scratch);
+                const auto [first, last] = std::ranges::unique(scratch);
+                lower_ids.insert(lower_ids.end(), scratch.begin(), first);
+                lower_offsets.push_back(static_cast<std::uint32_t>(lower_ids.size()));
+            }
+            std::swap(upper_ids, lower_ids);
+            std::swap(upper_offsets, lower_offsets);
         }
-        // 2. Initialize path count to 0.
-        auto path_count = 0;
-        // 3. For each valid neighbor with height + 1, add its count_distinct_paths to total.
-        int dr[] = {-1, 1, 0, 0};
-        int dc[] = {0, 0, -1, 1};
 
-        for (int i = 0; i < 4; ++i)
+        return static_cast<long long>(upper_ids.size());
+    }
+
+    TrailTotals analyze_trails(const std::vector<std::string>& input, const std::size_t dense_budget_bytes)
+    {
+        const HeightMap map = build_height_map(input);
+
+        std::size_t widest_layer = 0;
+        for (const auto& layer : map.layers)
         {
-            int nr = r + dr[i];
-            int nc = c + dc[i];
+            widest_layer = std::max(widest_layer, layer.size());
+        }
+        const std::size_t dense_bytes = 2 * widest_layer * ((map.layers[9].size() + 63) / 64) * sizeof(std::uint64_t);
 
-            if (is_valid(nr, nc, grid.size(), grid[0].size()) && grid[nr][nc] == current_height + 1)
-            {
-                path_count += count_distinct_paths(nr, nc, grid, memo);
-            }
+        auto paths = seed_paths(map);
+        TrailTotals totals{};
+        totals.score_sum = dense_bytes <= dense_budget_bytes ? sweep_dense(map, paths) : sweep_sparse(map, paths);
+        for (const auto index : map.layers[0])
+        {
+            totals.rating_sum += paths[index];
         }
-        // 4. Return total.
-        memo[r][c] = path_count;
-        return path_count;
+        return totals;
     }
 
-    std::string solve_part1(const std::vector<std::string>& input)
+    // ============================================================================
+    // INCREMENTAL TRAIL INDEX
+    // ============================================================================
+
+    TrailIndex::TrailIndex(const std::vector<std::string>& input)
     {
-        auto result = 0;
-        std::vector<std::vector<int>> grid;
-        grid.reserve(input.size());
-        for (const auto& line : input)
+        const HeightMap map = build_height_map(input);
+        rows_ = map.rows;
+        cols_ = map.cols;
+        heights_ = map.heights;
+        up_.assign(heights_.size(), 0);
+        down_.assign(heights_.size(), 0);
+        nines_.assign(heights_.size(), {});
+        visited_epoch_.assign(heights_.size(), 0);
+
+        for (int height = 9; height >= 0; --height)
         {
-            std::vector<int> row;
-            row.reserve(line.size());
-            for (char c : line)
-            {
-                row.push_back(c - '0');
-            }
-            grid.push_back(std::move(row));
+            for (const auto index : map.layers[height]) recompute_up(index);
         }
-        for (size_t r = 0; r < grid.size(); ++r)
+        for (int height = 0; height <= 9; ++height)
         {
-            for (size_t c = 0; c < grid[r].size(); ++c)
-            {
-                int digit = grid[r][c];
-                if (digit == 0)
-                {
-                    std::set<std::pair<int, int>> found_nines;
-                    find_reachable_nines(static_cast<int>(r), static_cast<int>(c), grid, found_nines);
-                    result += found_nines.size();
-                }
-            }
+            for (const auto index : map.layers[height]) recompute_down(index);
+        }
+        for (const auto index : map.layers[0])
+        {
+            total_rating_ += up_[index];
+            total_score_ += static_cast<long long>(nines_[index].size());
         }
-        return std::to_string(result);
     }
 
-    std::string solve_part2(const std::vector<std::string>& input)
+    std::uint32_t TrailIndex::index_of(const int row, const int col) const
     {
-        auto result = 0;
-        std::vector<std::vector<int>> grid;
-        grid.reserve(input.size());
-        for (const auto& line : input)
+        if (row < 0 || row >= rows_ || col < 0 || col >= cols_)
+        {
+            throw std::invalid_argument("Cell lies outside the trail map");
+        }
+        return static_cast<std::uint32_t>(row * cols_ + col);
+    }
+
+    long long TrailIndex::rating(const int row, const int col) const
+    {
+        return up_[index_of(row, col)];
+    }
+
+    long long TrailIndex::score(const int row, const int col) const
+    {
+        return static_cast<long long>(nines_[index_of(row, col)].size());
+    }
+
+    long long TrailIndex::trails_ending_at(const int row, const int col) const
+    {
+        return down_[index_of(row, col)];
+    }
+
+    long long TrailIndex::total_rating() const
+    {
+        return total_rating_;
+    }
+
+    long long TrailIndex::total_score() const
+    {
+        return total_score_;
+    }
+
+    /**
+     * @brief Calls fn(neighbour) for every orthogonal neighbour at height h + step
+     */
+    template <typename Fn>
+    void for_each_step(const std::vector<std::uint8_t>& heights, const int rows, const int cols,
+                       const std::uint32_t index, const int step, Fn&& fn)
+    {
+        const int height = heights[index];
+        if (height == kImpassable || height + step < 0 || height + step > 9) return;
+
+        const auto next = static_cast<std::uint8_t>(height + step);
+        const int r = static_cast<int>(index) / cols;
+        const int c = static_cast<int>(index) % cols;
+        if (r > 0 && heights[index - cols] == next) fn(index - cols);
+        if (r + 1 < rows && heights[index + cols] == next) fn(index + cols);
+        if (c > 0 && heights[index - 1] == next) fn(index - 1);
+        if (c + 1 < cols && heights[index + 1] == next) fn(index + 1);
+    }
+
+    void TrailIndex::recompute_up(const std::uint32_t index)
+    {
+        auto& nines = nines_[index];
+        nines.clear();
+        up_[index] = 0;
+
+        if (heights_[index] == 9)
+        {
+            up_[index] = 1;
+            nines.push_back(index);
+            return;
+        }
+
+        for_each_step(heights_, rows_, cols_, index, +1, [&](std::uint32_t next)
         {
-            std::vector<int> row;
-            row.reserve(line.size());
-            for (char c : line)
+            up_[index] += up_[next];
+            nines.insert(nines.end(), nines_[next].begin(), nines_[next].end());
+        });
+        std::ranges::sort(nines);
+        const auto [first, last] = std::ranges::unique(nines);
+        nines.erase(first, last);
+    }
+
+    void TrailIndex::recompute_down(const std::uint32_t index)
+    {
+        down_[index] = heights_[index] == 0 ? 1 : 0;
+        for_each_step(heights_, rows_, cols_, index, -1, [&](std::uint32_t next)
+        {
+            down_[index] += down_[next];
+        });
+    }
+
+    /**
+     * @brief Seeds plus every cell reachable from them by repeated steps of `step`
+     * @param seeds Starting cells
+     * @param step -1 to collect cells that climb into the seeds, +1 for cells they climb to
+     */
+    std::vector<std::uint32_t> TrailIndex::collect_cone(const std::vector<std::uint32_t>& seeds, const int step)
+    {
+        if (++epoch_ == 0)
+        {
+            std::ranges::fill(visited_epoch_, 0);
+            epoch_ = 1;
+        }
+
+        std::vector<std::uint32_t> cone;
+        auto visit = [&](const std::uint32_t cell)
+        {
+            if (visited_epoch_[cell] == epoch_) return;
+            visited_epoch_[cell] = epoch_;
+            cone.push_back(cell);
+        };
+        for (const auto seed : seeds) visit(seed);
+
+        for (std::size_t i = 0; i < cone.size(); ++i)
+        {
+            for_each_step(heights_, rows_, cols_, cone[i], step, visit);
+        }
+        return cone;
+    }
+
+    void TrailIndex::set_height(const int row, const int col, const char height)
+    {
+        const std::uint32_t index = index_of(row, col);
+        const std::uint8_t old_height = heights_[index];
+        const std::uint8_t new_height =
+            height >= '0' && height <= '9' ? static_cast<std::uint8_t>(height - '0') : kImpassable;
+        if (old_height == new_height) return;
+
+        // Neighbours that depended on the old edges of the edited cell
+        std::vector<std::uint32_t> down_seeds{index};
+        std::vector<std::uint32_t> up_seeds{index};
+        for_each_step(heights_, rows_, cols_, index, -1, [&](std::uint32_t next) { down_seeds.push_back(next); });
+        for_each_step(heights_, rows_, cols_, index, +1, [&](std::uint32_t next) { up_seeds.push_back(next); });
+
+        if (old_height == 0)
+        {
+            total_rating_ -= up_[index];
+            total_score_ -= static_cast<long long>(nines_[index].size());
+        }
+        heights_[index] = new_height;
+
+        // Downward cone: cells whose trails to the 9s may have changed.
+        // Trailheads in it are re-added to the totals after the update.
+        auto cone = collect_cone(down_seeds, -1);
+        auto by_height = [&](std::uint32_t a, std::uint32_t b) { return heights_[a] > heights_[b]; };
+        std::ranges::sort(cone, by_height);
+        for (const auto cell : cone)
+        {
+            if (cell != index && heights_[cell] == 0)
+            {
+                total_rating_ -= up_[cell];
+                total_score_ -= static_cast<long long>(nines_[cell].size());
+            }
+            if (heights_[cell] == kImpassable)
+            {
+                up_[cell] = 0;
+                nines_[cell].clear();
+                continue;
+            }
+            recompute_up(cell);
+            if (heights_[cell] == 0)
             {
-                row.push_back(c - '0');
+                total_rating_ += up_[cell];
+                total_score_ += static_cast<long long>(nines_[cell].size());
             }
-            grid.push_back(std::move(row));
         }
-        std::vector<std::vector<int>> memo(grid.size(), std::vector<int>(grid[0].size(), -1));
-        for (size_t r = 0; r < grid.size(); ++r)
+
+        // Upward cone: cells whose trail counts from the 0s may have changed
+        cone = collect_cone(up_seeds, +1);
+        std::ranges::sort(cone, [&](std::uint32_t a, std::uint32_t b) { return by_height(b, a); });
+        for (const auto cell : cone)
         {
-            for (size_t c = 0; c < grid[r].size(); ++c)
+            if (heights_[cell] == kImpassable)
             {
-                int digit = grid[r][c];
-                if (digit == 0)
-                {
-                    result += count_distinct_paths(static_cast<int>(r), static_cast<int>(c), grid, memo);
-                }
+                down_[cell] = 0;
+                continue;
             }
+            recompute_down(cell);
         }
-        return std::to_string(result);
+    }
+
+    std::string solve_part1(const std::vector<std::string>& input)
+    {
+        return std::to_string(analyze_trails(input).score_sum);
+    }
+
+    std::string solve_part2(const std::vector<std::string>& input)
+    {
+        return std::to_string(analyze_trails(input).rating_sum);
     }
 } // namespace aoc::day10
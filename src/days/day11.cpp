@@ -1,125 +1,741 @@
 /**
  * @file day11.cpp
  * @brief Implementation of Day 11: Plutonian Pebbles
+ *
+ * OPTIMIZATION: Interned stone ids instead of a fresh std::unordered_map per blink.
+ * - Each distinct value gets a dense id from an open-addressing table.
+ * - Its children (1 or 2 ids) are computed once, with integer digit counting,
+ *   and cached for every later blink.
+ * - Counts live in two id-indexed arrays that are swapped after each blink;
+ *   only ids that are actually present are visited and cleared.
+ *
+ * ARBITRARY DEPTH: The reachable values form a closed graph of a few
+ * thousand nodes, so totals obey a linear recurrence. count_stones_mod()
+ * finds it with Berlekamp-Massey and jumps to any blink count with
+ * Kitamasa's method; count_stones_exact() walks the graph with big counts.
+ *
+ * PARALLELISM: count_stones_parallel() gives every worker a private shard of
+ * values (by hash). Outboxes are double-buffered by blink parity, so a single
+ * std::barrier per blink separates "transform own shard" from "merge inbound".
  */
 
 #include "days/day11.hpp"
 
+#include "utils/math_utils.hpp"
+
 #include <algorithm>
+#include <array>
+#include <barrier>
+#include <bit>
+#include <sstream>
+#include <stdexcept>
 #include <string>
-#include <vector>
+#include <thread>
 #include <unordered_map>
-#include <cmath>
-#include <numeric>
-#include <ranges>
-#include <sstream>
+#include <utility>
+#include <vector>
 
 namespace aoc::day11
 {
+    // ============================================================================
+    // STONE RULES
+    // ============================================================================
+
+    /// Powers of ten that fit in 64 bits
+    constexpr std::array<std::uint64_t, 20> kPow10 = []
+    {
+        std::array<std::uint64_t, 20> powers{};
+        powers[0] = 1;
+        for (std::size_t i = 1; i < powers.size(); ++i) powers[i] = powers[i - 1] * 10;
+        return powers;
+    }();
+
     /**
-     * @brief Logic for transforming a single stone based on the puzzle rules.
-     *
-     * Rules:
-     * 1. If the stone's number is 0, it is replaced by a stone with number 1.
-     * 2. If the stone's number has an even number of digits, it is replaced by two stones:
-     *    the left half and the right half of the digits respectively.
-     * 3. If neither rule applies, the stone's number is multiplied by 2024.
-     *
-     * Tip: To split even digits, use `std::to_string` and `std::stoll`, or
-     * mathematical operations like `log10` and `pow` for better performance.
+     * @brief Number of decimal digits of a value (0 has one digit)
+     */
+    [[nodiscard]] int count_digits(const std::uint64_t value)
+    {
+        int digits = 1;
+        while (digits < static_cast<int>(kPow10.size()) && value >= kPow10[digits]) ++digits;
+        return digits;
+    }
+
+    /**
+     * @brief Applies the rules to one stone
+     * @param value Stone value
+     * @param left First child
+     * @param right Second child (only written when the stone splits)
+     * @return Number of children, 1 or 2
      */
-    std::vector<long long> transform_stone(long long value)
+    int stone_children(const std::uint64_t value, std::uint64_t& left, std::uint64_t& right)
     {
         if (value == 0)
         {
-            return {1ll};
+            left = 1;
+            return 1;
+        }
+        if (const int digits = count_digits(value); digits % 2 == 0)
+        {
+            const std::uint64_t divisor = kPow10[digits / 2];
+            left = value / divisor;
+            right = value % divisor;
+            return 2;
+        }
+        left = value * 2024;
+        return 1;
+    }
+
+    /**
+     * @brief Mixes a stone value into a table hash
+     */
+    [[nodiscard]] std::uint64_t hash_stone(std::uint64_t value)
+    {
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdULL;
+        value ^= value >> 33;
+        return value;
+    }
+
+    std::vector<std::uint64_t> parse_stones(const std::vector<std::string>& input)
+    {
+        std::vector<std::uint64_t> stones;
+        if (input.empty()) return stones;
+
+        std::istringstream ss(input[0]);
+        std::uint64_t value;
+        while (ss >> value)
+        {
+            stones.push_back(value);
+        }
+        return stones;
+    }
+
+    // ============================================================================
+    // BLINK ENGINE
+    // ============================================================================
+
+    BlinkEngine::BlinkEngine(const std::vector<std::uint64_t>& stones)
+    {
+        slots_.assign(1024, kNone);
+        for (const auto value : stones)
+        {
+            const auto id = intern(value);
+            if (counts_[id]++ == 0) active_.push_back(id);
+        }
+    }
+
+    void BlinkEngine::grow_table()
+    {
+        slots_.assign(slots_.size() * 2, kNone);
+        const std::size_t mask = slots_.size() - 1;
+        for (std::uint32_t id = 0; id < values_.size(); ++id)
+        {
+            std::size_t slot = hash_stone(values_[id]) & mask;
+            while (slots_[slot] != kNone) slot = (slot + 1) & mask;
+            slots_[slot] = id;
+        }
+    }
+
+    std::uint32_t BlinkEngine::intern(const std::uint64_t value)
+    {
+        const std::size_t mask = slots_.size() - 1;
+        std::size_t slot = hash_stone(value) & mask;
+        while (slots_[slot] != kNone)
+        {
+            if (values_[slots_[slot]] == value) return slots_[slot];
+            slot = (slot + 1) & mask;
         }
 
-        int digits = static_cast<int>(std::log10(value)) + 1;
-        if (digits % 2 == 0)
+        const auto id = static_cast<std::uint32_t>(values_.size());
+        values_.push_back(value);
+        transitions_.emplace_back();
+        counts_.push_back(0);
+        next_counts_.push_back(0);
+        slots_[slot] = id;
+        if (values_.size() * 2 > slots_.size()) grow_table();
+        return id;
+    }
+
+    const BlinkEngine::Transition& BlinkEngine::transition(const std::uint32_t id)
+    {
+        if (transitions_[id].left != kNone) return transitions_[id];
+
+        std::uint64_t left = 0;
+        std::uint64_t right = 0;
+        Transition result{};
+        const int children = stone_children(values_[id], left, right);
+        result.left = intern(left);
+        if (children == 2) result.right = intern(right);
+
+        // intern() may have reallocated transitions_, so index again
+        transitions_[id] = result;
+        return transitions_[id];
+    }
+
+    void BlinkEngine::blink(const int times)
+    {
+        for (int i = 0; i < times; ++i)
         {
-            long long divisor = std::pow(10, digits / 2);
-            return {value / divisor, value % divisor};
+            next_active_.clear();
+            for (const auto id : active_)
+            {
+                const std::uint64_t count = counts_[id];
+                counts_[id] = 0;
+
+                const Transition children = transition(id);
+                for (const auto child : {children.left, children.right})
+                {
+                    if (child == kNone) continue;
+                    if (next_counts_[child] == 0) next_active_.push_back(child);
+                    next_counts_[child] += count;
+                }
+            }
+            std::swap(counts_, next_counts_);
+            std::swap(active_, next_active_);
         }
-        else
+    }
+
+    std::uint64_t BlinkEngine::stone_count() const
+    {
+        std::uint64_t total = 0;
+        for (const auto id : active_)
         {
-            return {value * 2024};
+            total += counts_[id];
         }
+        return total;
+    }
+
+    std::size_t BlinkEngine::distinct_values() const
+    {
+        return values_.size();
     }
 
+    // ============================================================================
+    // PARALLEL BLINKING
+    // ============================================================================
+
     /**
-     * @brief Simulates a single blink across all stones using a frequency map.
+     * @brief Value -> count table owned by a single worker
      *
-     * Strategy:
-     * - Observe that the order of stones doesn't matter, and many stones share the same value.
-     * - Create a new `next_counts` map.
-     * - For each `[value, count]` in `current_counts`:
-     *    1. Transform the `value` into 1 or 2 `new_values`.
-     *    2. Add the original `count` to `next_counts[new_value]`.
+     * Open addressing over an entry list; the entry list doubles as the
+     * iteration order. The table keeps its capacity across blinks.
      */
-    std::unordered_map<long long, long long> blink(const std::unordered_map<long long, long long>& current_counts)
+    class ShardCounts
+    {
+    public:
+        ShardCounts() : slots_(64, kEmpty)
+        {
+        }
+
+        void add(const std::uint64_t value, const std::uint64_t count)
+        {
+            if (2 * (entries_.size() + 1) > slots_.size()) grow();
+            const std::size_t mask = slots_.size() - 1;
+            std::size_t slot = hash_stone(value) & mask;
+            while (slots_[slot] != kEmpty)
+            {
+                if (entries_[slots_[slot]].first == value)
+                {
+                    entries_[slots_[slot]].second += count;
+                    return;
+                }
+                slot = (slot + 1) & mask;
+            }
+            slots_[slot] = static_cast<std::uint32_t>(entries_.size());
+            entries_.emplace_back(value, count);
+        }
+
+        [[nodiscard]] const std::vector<std::pair<std::uint64_t, std::uint64_t>>& entries() const
+        {
+            return entries_;
+        }
+
+        void clear()
+        {
+            std::ranges::fill(slots_, kEmpty);
+            entries_.clear();
+        }
+
+    private:
+        static constexpr std::uint32_t kEmpty = 0xFFFFFFFFu;
+
+        std::vector<std::uint32_t> slots_;
+        std::vector<std::pair<std::uint64_t, std::uint64_t>> entries_;
+
+        void grow()
+        {
+            slots_.assign(slots_.size() * 2, kEmpty);
+            const std::size_t mask = slots_.size() - 1;
+            for (std::uint32_t index = 0; index < entries_.size(); ++index)
+            {
+                std::size_t slot = hash_stone(entries_[index].first) & mask;
+                while (slots_[slot] != kEmpty) slot = (slot + 1) & mask;
+                slots_[slot] = index;
+            }
+        }
+    };
+
+    std::uint64_t count_stones_parallel(const std::vector<std::uint64_t>& stones, const int blinks,
+                                        unsigned thread_count)
     {
-        std::unordered_map<long long, long long> next_counts;
-        for (const auto& [value, count] : current_counts)
+        if (thread_count == 0) thread_count = std::max(1u, std::thread::hardware_concurrency());
+        const std::size_t workers_n = thread_count;
+
+        // Shard by the high hash bits; the tables index with the low ones
+        auto owner = [workers_n](const std::uint64_t value)
+        {
+            return static_cast<std::size_t>((hash_stone(value) >> 32) % workers_n);
+        };
+
+        std::vector<ShardCounts> shards(workers_n);
+        for (const auto value : stones) shards[owner(value)].add(value, 1);
+
+        // outboxes[parity][from * workers + to]; written by `from` in blinks of
+        // that parity and drained by `to` right after the barrier. Double
+        // buffering means a sender can start the next blink while the receiver
+        // is still draining the previous one.
+        using Outbox = std::vector<std::pair<std::uint64_t, std::uint64_t>>;
+        std::array<std::vector<Outbox>, 2> outboxes{std::vector<Outbox>(workers_n * workers_n),
+                                                    std::vector<Outbox>(workers_n * workers_n)};
+        std::barrier sync(static_cast<std::ptrdiff_t>(workers_n));
+
+        auto worker = [&](const std::size_t self)
         {
-            auto new_values = transform_stone(value);
-            for (long long new_value : new_values)
+            ShardCounts& shard = shards[self];
+            for (int step = 0; step < blinks; ++step)
             {
-                next_counts[new_value] += count;
+                auto& boxes = outboxes[step & 1];
+                for (const auto& [value, count] : shard.entries())
+                {
+                    std::uint64_t left = 0;
+                    std::uint64_t right = 0;
+                    const int children = stone_children(value, left, right);
+                    boxes[self * workers_n + owner(left)].emplace_back(left, count);
+                    if (children == 2) boxes[self * workers_n + owner(right)].emplace_back(right, count);
+                }
+                shard.clear();
+
+                sync.arrive_and_wait();
+
+                for (std::size_t from = 0; from < workers_n; ++from)
+                {
+                    Outbox& inbox = boxes[from * workers_n + self];
+                    for (const auto& [value, count] : inbox) shard.add(value, count);
+                    inbox.clear();
+                }
+            }
+        };
+
+        {
+            std::vector<std::jthread> threads;
+            threads.reserve(workers_n);
+            for (std::size_t t = 0; t < workers_n; ++t)
+            {
+                threads.emplace_back(worker, t);
             }
+        }
 
+        std::uint64_t total = 0;
+        for (const auto& shard : shards)
+        {
+            for (const auto& entry : shard.entries()) total += entry.second;
         }
-        return next_counts;
+        return total;
     }
 
+    // ============================================================================
+    // ARBITRARY-DEPTH BLINKING
+    // ============================================================================
+
     /**
-     * @brief Part 1: How many stones after 25 blinks?
+     * @brief Closed transition graph of all values reachable from the input
      */
-    std::string solve_part1(const std::vector<std::string>& input)
+    struct StoneGraph
     {
-        // 1. Parse the input string into a `std::unordered_map<long long, long long>`
-        std::stringstream ss(input[0]);
-        std::unordered_map<long long, long long> current_counts;
-        long long value;
-        while (ss >> value)
+        std::vector<std::array<std::uint32_t, 2>> children; ///< Second entry is kNoChild for 1-child stones
+        std::vector<std::uint64_t> initial;                 ///< Stone count per node before blinking
+    };
+
+    constexpr std::uint32_t kNoChild = 0xFFFFFFFFu;
+
+    [[nodiscard]] StoneGraph build_stone_graph(const std::vector<std::uint64_t>& stones)
+    {
+        std::unordered_map<std::uint64_t, std::uint32_t> ids;
+        std::vector<std::uint64_t> values;
+        auto id_of = [&](const std::uint64_t value)
         {
-            current_counts[value]++;
+            const auto [it, inserted] = ids.try_emplace(value, static_cast<std::uint32_t>(values.size()));
+            if (inserted) values.push_back(value);
+            return it->second;
+        };
+
+        StoneGraph graph;
+        for (const auto value : stones)
+        {
+            const auto id = id_of(value);
+            if (graph.initial.size() <= id) graph.initial.resize(id + 1, 0);
+            ++graph.initial[id];
         }
-        // 2. Loop 25 times calling blink()
-        for (int i = 0; i < 25; ++i)
+
+        // values grows while we walk it: breadth-first closure
+        for (std::size_t id = 0; id < values.size(); ++id)
         {
-            current_counts = blink(current_counts);
+            std::uint64_t left = 0;
+            std::uint64_t right = 0;
+            const int count = stone_children(values[id], left, right);
+            std::array<std::uint32_t, 2> next{id_of(left), kNoChild};
+            if (count == 2) next[1] = id_of(right);
+            graph.children.push_back(next);
         }
-        // 3. Sum all values (the counts) in the final map.
-        const auto result = std::ranges::fold_left(current_counts | std::views::values, 0LL, std::plus<>());
+        graph.initial.resize(values.size(), 0);
+        return graph;
+    }
 
-        return std::to_string(result);
+    /**
+     * @brief Modular arithmetic for moduli below 2^62
+     *
+     * Products fit a signed 128-bit integer with room for seven of them, so
+     * dot products are reduced once per seven terms instead of once per term.
+     */
+    class ModArith
+    {
+    public:
+        explicit ModArith(const std::uint64_t modulus) : m_(modulus)
+        {
+        }
+
+        [[nodiscard]] std::uint64_t add(const std::uint64_t a, const std::uint64_t b) const
+        {
+            const std::uint64_t sum = a + b;
+            return sum >= m_ ? sum - m_ : sum;
+        }
+
+        [[nodiscard]] std::uint64_t sub(const std::uint64_t a, const std::uint64_t b) const
+        {
+            return a >= b ? a - b : a + m_ - b;
+        }
+
+        [[nodiscard]] std::uint64_t mul(const std::uint64_t a, const std::uint64_t b) const
+        {
+            return static_cast<std::uint64_t>(aoc::utils::int128{a} * b % m_);
+        }
+
+        [[nodiscard]] std::uint64_t pow(std::uint64_t base, std::uint64_t exponent) const
+        {
+            std::uint64_t result = 1 % m_;
+            for (; exponent > 0; exponent >>= 1)
+            {
+                if (exponent & 1) result = mul(result, base);
+                base = mul(base, base);
+            }
+            return result;
+        }
+
+        /// Modular inverse via Fermat's little theorem (modulus must be prime)
+        [[nodiscard]] std::uint64_t inverse(const std::uint64_t a) const
+        {
+            return pow(a, m_ - 2);
+        }
+
+        /// Sum of a[i] * b[i] for i in [0, n)
+        [[nodiscard]] std::uint64_t dot(const std::uint64_t* a, const std::uint64_t* b, const std::size_t n) const
+        {
+            aoc::utils::int128 acc = 0;
+            std::uint64_t result = 0;
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                acc += aoc::utils::int128{a[i]} * b[i];
+                if (i % 7 == 6)
+                {
+                    result = add(result, static_cast<std::uint64_t>(acc % m_));
+                    acc = 0;
+                }
+            }
+            return add(result, static_cast<std::uint64_t>(acc % m_));
+        }
+
+    private:
+        std::uint64_t m_;
+    };
+
+    /**
+     * @brief Total stone counts after 0, 1, ..., terms - 1 blinks, modulo m
+     */
+    [[nodiscard]] std::vector<std::uint64_t> stone_totals_mod(const StoneGraph& graph, const std::size_t terms,
+                                                              const ModArith& mod)
+    {
+        std::vector<std::uint64_t> counts(graph.initial.size());
+        std::vector<std::uint64_t> next(graph.initial.size());
+        for (std::size_t id = 0; id < counts.size(); ++id)
+        {
+            counts[id] = mod.mul(graph.initial[id], 1);
+        }
+
+        std::vector<std::uint64_t> totals;
+        totals.reserve(terms);
+        for (std::size_t step = 0; step < terms; ++step)
+        {
+            std::uint64_t total = 0;
+            for (const auto count : counts) total = mod.add(total, count);
+            totals.push_back(total);
+
+            std::ranges::fill(next, 0);
+            for (std::size_t id = 0; id < counts.size(); ++id)
+            {
+                if (counts[id] == 0) continue;
+                for (const auto child : graph.children[id])
+                {
+                    if (child != kNoChild) next[child] = mod.add(next[child], counts[id]);
+                }
+            }
+            std::swap(counts, next);
+        }
+        return totals;
     }
 
     /**
-     * @brief Part 2: How many stones after 75 blinks?
+     * @brief Shortest linear recurrence of a sequence over a prime field
+     * @return c such that s[n] = sum(c[i] * s[n - 1 - i]) for all valid n
+     */
+    [[nodiscard]] std::vector<std::uint64_t> berlekamp_massey(const std::vector<std::uint64_t>& sequence,
+                                                              const ModArith& mod)
+    {
+        std::vector<std::uint64_t> current{1};  // connection polynomial C(x)
+        std::vector<std::uint64_t> previous{1}; // B(x) at the last length change
+        std::size_t length = 0;
+        std::size_t shift = 1;
+        std::uint64_t previous_discrepancy = 1;
+
+        for (std::size_t n = 0; n < sequence.size(); ++n)
+        {
+            std::uint64_t discrepancy = sequence[n];
+            for (std::size_t i = 1; i <= length; ++i)
+            {
+                discrepancy = mod.add(discrepancy, mod.mul(current[i], sequence[n - i]));
+            }
+            if (discrepancy == 0)
+            {
+                ++shift;
+                continue;
+            }
+
+            const std::vector<std::uint64_t> saved = current;
+            const std::uint64_t factor = mod.mul(discrepancy, mod.inverse(previous_discrepancy));
+            if (current.size() < previous.size() + shift) current.resize(previous.size() + shift, 0);
+            for (std::size_t i = 0; i < previous.size(); ++i)
+            {
+                current[i + shift] = mod.sub(current[i + shift], mod.mul(factor, previous[i]));
+            }
+
+            if (2 * length <= n)
+            {
+                length = n + 1 - length;
+                previous = saved;
+                previous_discrepancy = discrepancy;
+                shift = 1;
+            }
+            else
+            {
+                ++shift;
+            }
+        }
+
+        current.resize(length + 1, 0);
+        std::vector<std::uint64_t> recurrence(length);
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            recurrence[i] = mod.sub(0, current[i + 1]);
+        }
+        return recurrence;
+    }
+
+    /**
+     * @brief n-th term of a linear recurrence (Kitamasa's method)
      *
-     * Note: Simple simulation (vector) will fail here due to exponential growth.
-     * The frequency map approach (above) handles this efficiently.
+     * Computes x^n modulo the characteristic polynomial by square-and-multiply;
+     * the remainder's coefficients weight the first terms of the sequence.
      */
-    std::string solve_part2(const std::vector<std::string>& input)
+    [[nodiscard]] std::uint64_t nth_term(const std::vector<std::uint64_t>& recurrence,
+                                         const std::vector<std::uint64_t>& sequence, std::uint64_t n,
+                                         const ModArith& mod)
     {
-        std::stringstream ss(input[0]);
-        std::unordered_map<long long, long long> current_counts;
-        while (ss.good())
+        const std::size_t order = recurrence.size();
+        if (order == 0) return 0;
+        if (n < sequence.size()) return sequence[n];
+
+        // Polynomials of degree < order; x^order = sum(recurrence[i] * x^(order - 1 - i))
+        auto reduce = [&](std::vector<std::uint64_t>& poly)
         {
-            long long value;
-            ss >> value;
-            current_counts[value] = 1;
+            for (std::size_t degree = poly.size() - 1; degree >= order; --degree)
+            {
+                const std::uint64_t lead = poly[degree];
+                if (lead == 0) continue;
+                for (std::size_t i = 0; i < order; ++i)
+                {
+                    poly[degree - 1 - i] = mod.add(poly[degree - 1 - i], mod.mul(lead, recurrence[i]));
+                }
+            }
+            poly.resize(order);
+        };
+
+        std::vector<std::uint64_t> reversed(order);
+        auto multiply = [&](const std::vector<std::uint64_t>& a, const std::vector<std::uint64_t>& b)
+        {
+            // Convolution as dot products against the reversed second operand
+            std::ranges::reverse_copy(b, reversed.begin());
+            std::vector<std::uint64_t> product(2 * order - 1);
+            for (std::size_t k = 0; k < product.size(); ++k)
+            {
+                const std::size_t lo = k >= order - 1 ? k - (order - 1) : 0;
+                const std::size_t hi = std::min(k, order - 1);
+                product[k] = mod.dot(&a[lo], &reversed[order - 1 - (k - lo)], hi - lo + 1);
+            }
+            reduce(product);
+            return product;
+        };
+
+        std::vector<std::uint64_t> result(order, 0);
+        result[0] = 1; // x^0
+        const int top_bit = 63 - std::countl_zero(n);
+        for (int bit = top_bit; bit >= 0; --bit)
+        {
+            result = multiply(result, result);
+            if ((n >> bit) & 1)
+            {
+                // Multiply by x: shift up one degree and fold the overflow back in
+                result.insert(result.begin(), 0);
+                reduce(result);
+            }
+        }
+
+        return mod.dot(result.data(), sequence.data(), order);
+    }
+
+    std::uint64_t count_stones_mod(const std::vector<std::uint64_t>& stones, const std::uint64_t blinks,
+                                   const std::uint64_t modulus)
+    {
+        if (modulus < 2 || modulus >= (std::uint64_t{1} << 62))
+            throw std::invalid_argument("Modulus must be a prime in [2, 2^62)");
+
+        const ModArith mod(modulus);
+        const StoneGraph graph = build_stone_graph(stones);
+
+        // A recurrence of order <= |values| is pinned down by twice as many terms
+        const std::size_t terms = 2 * graph.children.size() + 2;
+        if (blinks < terms)
+        {
+            return stone_totals_mod(graph, static_cast<std::size_t>(blinks) + 1, mod).back();
         }
-        // 2. Loop 75 times calling blink()
-        for (int i = 0; i < 75; ++i)
+
+        const auto totals = stone_totals_mod(graph, terms, mod);
+        const auto recurrence = berlekamp_massey(totals, mod);
+        return nth_term(recurrence, totals, blinks, mod);
+    }
+
+    /**
+     * @brief Minimal unsigned big integer (little-endian 64-bit limbs), add only
+     */
+    struct BigCount
+    {
+        std::vector<std::uint64_t> limbs;
+
+        void add(const BigCount& other)
         {
-            current_counts = blink(current_counts);
+            if (limbs.size() < other.limbs.size()) limbs.resize(other.limbs.size(), 0);
+            unsigned carry = 0;
+            std::size_t i = 0;
+            for (; i < other.limbs.size(); ++i)
+            {
+                std::uint64_t sum;
+                const bool overflow1 = __builtin_add_overflow(limbs[i], other.limbs[i], &sum);
+                const bool overflow2 = __builtin_add_overflow(sum, carry, &limbs[i]);
+                carry = overflow1 || overflow2;
+            }
+            for (; carry != 0 && i < limbs.size(); ++i)
+            {
+                carry = ++limbs[i] == 0;
+            }
+            if (carry != 0) limbs.push_back(1);
         }
-        // 3. Sum all values (the counts) in the final map.
-        const auto result = std::ranges::fold_left(current_counts | std::views::values, 0LL, std::plus<>());
 
-        return std::to_string(result);
+        [[nodiscard]] std::string to_string() const
+        {
+            constexpr std::uint64_t kChunk = 1000000000000000000ULL; // 10^18
+            std::vector<std::uint64_t> rest = limbs;
+            std::vector<std::uint64_t> chunks;
+            while (!rest.empty())
+            {
+                aoc::utils::int128 remainder = 0;
+                for (std::size_t i = rest.size(); i-- > 0;)
+                {
+                    const aoc::utils::int128 current = (remainder << 64) | rest[i];
+                    rest[i] = static_cast<std::uint64_t>(current / kChunk);
+                    remainder = current % kChunk;
+                }
+                chunks.push_back(static_cast<std::uint64_t>(remainder));
+                while (!rest.empty() && rest.back() == 0) rest.pop_back();
+            }
+            if (chunks.empty()) return "0";
+
+            std::string result = std::to_string(chunks.back());
+            for (std::size_t i = chunks.size() - 1; i-- > 0;)
+            {
+                const std::string chunk = std::to_string(chunks[i]);
+                result += std::string(18 - chunk.size(), '0') + chunk;
+            }
+            return result;
+        }
+    };
+
+    std::string count_stones_exact(const std::vector<std::uint64_t>& stones, const std::uint64_t blinks)
+    {
+        const StoneGraph graph = build_stone_graph(stones);
+        std::vector<BigCount> counts(graph.initial.size());
+        std::vector<BigCount> next(graph.initial.size());
+        for (std::size_t id = 0; id < counts.size(); ++id)
+        {
+            if (graph.initial[id] != 0) counts[id].limbs.push_back(graph.initial[id]);
+        }
+
+        for (std::uint64_t step = 0; step < blinks; ++step)
+        {
+            for (auto& count : next) count.limbs.clear();
+            for (std::size_t id = 0; id < counts.size(); ++id)
+            {
+                if (counts[id].limbs.empty()) continue;
+                for (const auto child : graph.children[id])
+                {
+                    if (child != kNoChild) next[child].add(counts[id]);
+                }
+            }
+            std::swap(counts, next);
+        }
+
+        BigCount total;
+        for (const auto& count : counts) total.add(count);
+        return total.to_string();
+    }
+
+    /**
+     * @brief Part 1: How many stones after 25 blinks?
+     */
+    std::string solve_part1(const std::vector<std::string>& input)
+    {
+        BlinkEngine engine(parse_stones(input));
+        engine.blink(25);
+        return std::to_string(engine.stone_count());
+    }
+
+    /**
+     * @brief Part 2: How many stones after 75 blinks?
+     *
+     * Note: Simple simulation (vector) will fail here due to exponential growth.
+     * The frequency-based engine (above) handles this efficiently.
+     */
+    std::string solve_part2(const std::vector<std::string>& input)
+    {
+        BlinkEngine engine(parse_stones(input));
+        engine.blink(75);
+        return std::to_string(engine.stone_count());
     }
 } // namespace aoc::day11
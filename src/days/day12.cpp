@@ -1,205 +1,767 @@
 /**
  * @file day12.cpp
  * @brief Implementation of Day 12: Garden Groups
+ *
+ * OPTIMIZATION: Single-pass union-find labeling instead of a BFS per region.
+ * - Only two rows of provisional labels are kept; the parent array and the
+ *   per-label accumulators grow with the number of provisional labels.
+ * - Perimeter is counted per cell from its four neighbours in the grid.
+ * - Corners are counted per grid vertex from the 2x2 window of cells around
+ *   it, so no set lookups are needed. The totals of provisional labels are
+ *   folded into their roots once at the end.
+ *
+ * PARALLELISM: analyze_regions_parallel() labels full-width row bands on
+ * separate threads. Only the vertices on a seam row see labels from two
+ * bands, so they (and the unions across the seam) are handled in a final
+ * merge that runs after all bands share one label space.
+ *
+ * INCREMENTAL: GardenIndex stores per-region sums of per-cell terms. An edit
+ * removes the terms of the 3x3 window, fixes the labels (a lockstep search
+ * from the old region's neighbours finds split-off parts; neighbouring
+ * regions of the new plant merge smaller-into-larger), then adds the window's
+ * new terms back. Only the touched regions' prices are re-added to the totals.
  */
 
 #include "days/day12.hpp"
 
-#include <queue>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
-#include <set>
-#include <tuple>
-#include <compare>
 
 namespace aoc::day12
 {
-    struct Point
+    // ============================================================================
+    // UNION-FIND LABELING
+    // ============================================================================
+
+    /// Plant used for cells outside the map; never equal to a real plant
+    constexpr char kOutside = '\0';
+
+    /**
+     * @brief Union-find over provisional labels with per-label accumulators
+     */
+    class LabelForest
     {
-        int r, c;
-        auto operator<=>(const Point&) const = default;
+    public:
+        [[nodiscard]] std::uint32_t make(const char plant)
+        {
+            const auto label = static_cast<std::uint32_t>(parent_.size());
+            parent_.push_back(label);
+            stats_.push_back(RegionStats{plant, 0, 0, 0});
+            return label;
+        }
+
+        [[nodiscard]] std::uint32_t find(std::uint32_t label)
+        {
+            while (parent_[label] != label)
+            {
+                parent_[label] = parent_[parent_[label]]; // path halving
+                label = parent_[label];
+            }
+            return label;
+        }
+
+        /// Joins two labels; the smaller root wins so roots stay in scan order
+        std::uint32_t unite(std::uint32_t a, std::uint32_t b)
+        {
+            a = find(a);
+            b = find(b);
+            if (a == b) return a;
+            if (b < a) std::swap(a, b);
+            parent_[b] = a;
+            return a;
+        }
+
+        /**
+         * @brief Appends another forest's labels after this one's
+         * @return Offset added to the other forest's labels
+         */
+        std::uint32_t absorb(const LabelForest& other)
+        {
+            const auto offset = static_cast<std::uint32_t>(parent_.size());
+            for (const auto parent : other.parent_) parent_.push_back(parent + offset);
+            stats_.insert(stats_.end(), other.stats_.begin(), other.stats_.end());
+            return offset;
+        }
+
+        [[nodiscard]] RegionStats& stats(const std::uint32_t label)
+        {
+            return stats_[label];
+        }
+
+        /// Folds every label's totals into its root and returns the roots' stats
+        [[nodiscard]] std::vector<RegionStats> collect()
+        {
+            std::vector<RegionStats> regions;
+            std::vector<std::uint32_t> region_of(parent_.size());
+            for (std::uint32_t label = 0; label < parent_.size(); ++label)
+            {
+                const std::uint32_t root = find(label);
+                if (root == label)
+                {
+                    region_of[label] = static_cast<std::uint32_t>(regions.size());
+                    regions.push_back(RegionStats{stats_[label].plant, 0, 0, 0});
+                }
+                RegionStats& region = regions[region_of[root]];
+                region.area += stats_[label].area;
+                region.perimeter += stats_[label].perimeter;
+                region.sides += stats_[label].sides;
+            }
+            return regions;
+        }
+
+    private:
+        std::vector<std::uint32_t> parent_;
+        std::vector<RegionStats> stats_;
     };
 
-    struct Region
+    /**
+     * @brief Adds the corners at one grid vertex to the regions around it
+     *
+     * Window positions are 0 = top-left, 1 = top-right, 2 = bottom-left,
+     * 3 = bottom-right. Same-plant cells in a window belong to one region
+     * unless they only touch diagonally; in that case each gets one corner,
+     * which is also right when they turn out to be the same region (two).
+     */
+    void add_vertex_corners(const std::array<char, 4>& plants, const std::array<std::uint32_t, 4>& labels,
+                            LabelForest& forest)
     {
-        char type;
-        std::vector<Point> cells;
-        std::set<Point> cell_set; // Useful for quick lookups
-    };
+        for (int p = 0; p < 4; ++p)
+        {
+            if (plants[p] == kOutside) continue;
+
+            unsigned group = 0;
+            bool leader = true;
+            for (int q = 0; q < 4; ++q)
+            {
+                if (plants[q] != plants[p]) continue;
+                if (q < p) leader = false;
+                group |= 1u << q;
+            }
+            if (!leader) continue;
+
+            switch (std::popcount(group))
+            {
+            case 1:
+            case 3:
+                ++forest.stats(labels[p]).sides;
+                break;
+            case 2:
+                if (group == 0b1001u || group == 0b0110u)
+                {
+                    for (int q = 0; q < 4; ++q)
+                    {
+                        if (group & (1u << q)) ++forest.stats(labels[q]).sides;
+                    }
+                }
+                break;
+            default:
+                break;
+            }
+        }
+    }
 
     /**
-     * @brief Checks if a given point is within the grid boundaries.
-     * 
-     * @param p The point (r, c) to check.
-     * @param grid The 2D vector of strings representing the grid.
-     * @return true if the point is within the grid bounds, false otherwise.
+     * @brief Plant at (r, c), or kOutside beyond the map (r and c may wrap)
      */
-    [[nodiscard]] bool is_in_bounds(const Point& p, const std::vector<std::string>& grid)
+    [[nodiscard]] char plant_at(const std::vector<std::string>& grid, const std::size_t r, const std::size_t c)
     {
-        return p.r >= 0 && p.r < static_cast<int>(grid.size()) &&
-            p.c >= 0 && p.c < static_cast<int>(grid[0].size());
+        return r < grid.size() && c < grid[r].size() ? grid[r][c] : kOutside;
     }
 
     /**
-     * @brief Uses Flood Fill (BFS/DFS) to find a contiguous region.
+     * @brief Adds the corners at vertex (r, c), the top-left corner of cell (r, c)
+     * @param upper Labels of row r - 1
+     * @param lower Labels of row r
+     */
+    void add_vertex(const std::vector<std::string>& grid, const std::size_t r, const std::size_t c,
+                    const std::vector<std::uint32_t>& upper, const std::vector<std::uint32_t>& lower,
+                    LabelForest& forest)
+    {
+        const std::array<char, 4> plants{plant_at(grid, r - 1, c - 1), plant_at(grid, r - 1, c),
+                                         plant_at(grid, r, c - 1), plant_at(grid, r, c)};
+        const std::array<std::uint32_t, 4> labels{
+            plants[0] != kOutside ? upper[c - 1] : 0, plants[1] != kOutside ? upper[c] : 0,
+            plants[2] != kOutside ? lower[c - 1] : 0, plants[3] != kOutside ? lower[c] : 0};
+        add_vertex_corners(plants, labels, forest);
+    }
+
+    /**
+     * @brief Labels rows [first_row, last_row) of the grid into `forest`
+     *
+     * Vertices on the strip's top edge are only handled when `own_top_edge`
+     * is set (the top of the map); otherwise they straddle a seam and are
+     * left to the merge. The bottom edge of the map is handled by the strip
+     * that ends there.
      *
-     * Strategy:
-     * 1. Start from (r, c) and find all connected cells of the same plant type.
-     * 2. Mark found cells in a `visited` 2D array to avoid reprocessing.
-     * 3. Store the region's plant type and all its coordinates.
+     * @param top_labels Receives the labels of the strip's first row
+     * @param bottom_labels Receives the labels of the strip's last row
+     */
+    void scan_strip(const std::vector<std::string>& grid, const std::size_t first_row, const std::size_t last_row,
+                    const bool own_top_edge, LabelForest& forest, std::vector<std::uint32_t>& top_labels,
+                    std::vector<std::uint32_t>& bottom_labels)
+    {
+        const std::size_t cols = grid[0].size();
+        std::vector<std::uint32_t> previous(cols);
+        std::vector<std::uint32_t> current(cols);
+
+        for (std::size_t r = first_row; r < last_row; ++r)
+        {
+            const bool strip_top = r == first_row;
+            const bool vertices = !strip_top || own_top_edge;
+            for (std::size_t c = 0; c < cols; ++c)
+            {
+                const char plant = plant_at(grid, r, c);
+                std::uint32_t label;
+                const bool joins_up = !strip_top && plant_at(grid, r - 1, c) == plant;
+                const bool joins_left = plant_at(grid, r, c - 1) == plant;
+                if (joins_up && joins_left) label = forest.unite(previous[c], current[c - 1]);
+                else if (joins_up) label = previous[c];
+                else if (joins_left) label = current[c - 1];
+                else label = forest.make(plant);
+                current[c] = label;
+
+                RegionStats& stats = forest.stats(label);
+                ++stats.area;
+                stats.perimeter += (plant_at(grid, r - 1, c) != plant) + !joins_left +
+                    (plant_at(grid, r + 1, c) != plant) + (plant_at(grid, r, c + 1) != plant);
+
+                if (vertices) add_vertex(grid, r, c, previous, current, forest);
+            }
+            if (vertices) add_vertex(grid, r, cols, previous, current, forest);
+            if (strip_top) top_labels = current;
+            std::swap(previous, current);
+        }
+        bottom_labels = previous;
+
+        if (last_row == grid.size())
+        {
+            for (std::size_t c = 0; c <= cols; ++c)
+            {
+                add_vertex(grid, last_row, c, previous, current, forest);
+            }
+        }
+    }
+
+    [[nodiscard]] std::size_t map_rows(const std::vector<std::string>& grid)
+    {
+        return grid.empty() || grid[0].empty() ? 0 : grid.size();
+    }
+
+    std::vector<RegionStats> analyze_regions(const std::vector<std::string>& grid)
+    {
+        const std::size_t rows = map_rows(grid);
+        if (rows == 0) return {};
+
+        LabelForest forest;
+        std::vector<std::uint32_t> top_labels;
+        std::vector<std::uint32_t> bottom_labels;
+        scan_strip(grid, 0, rows, true, forest, top_labels, bottom_labels);
+        return forest.collect();
+    }
+
+    // ============================================================================
+    // TILED PARALLEL LABELING
+    // ============================================================================
+
+    /**
+     * @brief Per-strip labeling result
      */
-    Region find_region(int r, int c, const std::vector<std::string>& grid, std::vector<std::vector<bool>>& visited)
+    struct Strip
     {
-        auto type = grid[r][c];
-        Region result{type, {}, {}};
+        std::size_t first_row = 0;
+        std::size_t last_row = 0;
+        LabelForest forest;
+        std::vector<std::uint32_t> top_labels;
+        std::vector<std::uint32_t> bottom_labels;
+    };
 
+    std::vector<RegionStats> analyze_regions_parallel(const std::vector<std::string>& grid, unsigned thread_count)
+    {
+        const std::size_t rows = map_rows(grid);
+        if (rows == 0) return {};
+        if (thread_count == 0) thread_count = std::max(1u, std::thread::hardware_concurrency());
 
-        std::queue<Point> queue{};
-        visited[r][c] = true;
-        queue.push(Point{r, c});
+        // Full-width row bands keep each seam to a single pair of rows
+        const std::size_t strip_count = std::min<std::size_t>(thread_count, rows);
+        std::vector<Strip> strips(strip_count);
+        for (std::size_t k = 0; k < strip_count; ++k)
+        {
+            strips[k].first_row = rows * k / strip_count;
+            strips[k].last_row = rows * (k + 1) / strip_count;
+        }
 
-        int dr[4] = {-1, 0, 1, 0};
-        int dc[4] = {0, 1, 0, -1};
-        while (!queue.empty())
         {
-            auto p = queue.front();
-            queue.pop();
+            std::vector<std::jthread> workers;
+            workers.reserve(strip_count);
+            for (std::size_t k = 0; k < strip_count; ++k)
+            {
+                workers.emplace_back(
+                    [&grid, &strip = strips[k], k]
+                    {
+                        scan_strip(grid, strip.first_row, strip.last_row, k == 0, strip.forest, strip.top_labels,
+                                   strip.bottom_labels);
+                    });
+            }
+        }
+
+        // Border merge: move every strip into one label space, join regions
+        // across each seam, then count the seam vertices' corners with the
+        // labels from both sides
+        LabelForest forest = std::move(strips[0].forest);
+        for (std::size_t k = 1; k < strip_count; ++k)
+        {
+            const std::uint32_t offset = forest.absorb(strips[k].forest);
+            for (auto& label : strips[k].top_labels) label += offset;
+            for (auto& label : strips[k].bottom_labels) label += offset;
+        }
+
+        const std::size_t cols = grid[0].size();
+        for (std::size_t k = 1; k < strip_count; ++k)
+        {
+            const std::size_t r = strips[k].first_row;
+            const auto& upper = strips[k - 1].bottom_labels;
+            const auto& lower = strips[k].top_labels;
+            for (std::size_t c = 0; c < cols; ++c)
+            {
+                if (grid[r - 1][c] == grid[r][c]) forest.unite(upper[c], lower[c]);
+            }
+            for (std::size_t c = 0; c <= cols; ++c)
+            {
+                add_vertex(grid, r, c, upper, lower, forest);
+            }
+        }
+
+        return forest.collect();
+    }
 
-            result.cells.push_back(p);
-            result.cell_set.insert(p);
+    // ============================================================================
+    // INCREMENTAL GARDEN INDEX
+    // ============================================================================
 
-            for (int i = 0; i < 4; ++i)
+    namespace
+    {
+        constexpr std::array<int, 4> kDr{-1, 0, 1, 0};
+        constexpr std::array<int, 4> kDc{0, 1, 0, -1};
+
+        [[nodiscard]] std::int64_t price_of(const RegionStats& region, const bool sides)
+        {
+            return region.area * (sides ? region.sides : region.perimeter);
+        }
+    } // namespace
+
+    GardenIndex::GardenIndex(const std::vector<std::string>& grid)
+    {
+        rows_ = map_rows(grid);
+        cols_ = rows_ == 0 ? 0 : grid[0].size();
+        plants_.resize(rows_ * cols_);
+        for (std::size_t r = 0; r < rows_; ++r)
+        {
+            for (std::size_t c = 0; c < cols_; ++c) plants_[r * cols_ + c] = plant_at(grid, r, c);
+        }
+        labels_.assign(plants_.size(), 0);
+        mark_epoch_.assign(plants_.size(), 0);
+        mark_search_.assign(plants_.size(), 0);
+
+        // Flood-fill initial labels; region sums are just sums of cell terms
+        std::vector<bool> seen(plants_.size(), false);
+        std::vector<std::size_t> stack;
+        for (std::size_t start = 0; start < plants_.size(); ++start)
+        {
+            if (seen[start]) continue;
+            const std::uint32_t region = new_region(plants_[start]);
+            seen[start] = true;
+            stack.push_back(start);
+            while (!stack.empty())
             {
-                Point next{p.r + dr[i], p.c + dc[i]};
-                if (is_in_bounds(next, grid) && grid[next.r][next.c] == type && !visited[next.r][next.c])
+                const std::size_t index = stack.back();
+                stack.pop_back();
+                labels_[index] = region;
+                add_terms(region, cell_terms(index), 1);
+                for (int d = 0; d < 4; ++d)
                 {
-                    visited[next.r][next.c] = true;
-                    queue.push(next);
+                    const std::size_t r = index / cols_ + kDr[d];
+                    const std::size_t c = index % cols_ + kDc[d];
+                    if (plant_or_outside(r, c) != plants_[index]) continue;
+                    if (const std::size_t next = r * cols_ + c; !seen[next])
+                    {
+                        seen[next] = true;
+                        stack.push_back(next);
+                    }
                 }
             }
+            perimeter_price_ += price_of(regions_[region], false);
+            sides_price_ += price_of(regions_[region], true);
         }
-        return result;
+    }
+
+    char GardenIndex::plant_or_outside(const std::size_t row, const std::size_t col) const
+    {
+        return row < rows_ && col < cols_ ? plants_[row * cols_ + col] : kOutside;
     }
 
     /**
-     * @brief Part 1: Perimeter Calculation.
+     * @brief Area, perimeter and corner terms a cell contributes to its region
      *
-     * Strategy:
-     * - For each cell in the region, check its 4 cardinal neighbors.
-     * - If a neighbor is outside the grid OR has a different plant type
-     *   (not in this region's cell_set), increment the perimeter count.
+     * The corner rule only inspects a diagonal when both adjacent orthogonal
+     * neighbours share the plant, and then the diagonal is in the same region
+     * iff it shares the plant too, so plants alone decide the terms.
      */
-    long long calculate_perimeter(const Region& region, const std::vector<std::string>& grid)
+    RegionStats GardenIndex::cell_terms(const std::size_t index) const
     {
-        long long result = 0;
-        int dr[4] = {-1, 0, 1, 0};
-        int dc[4] = {0, 1, 0, -1};
+        const std::size_t r = index / cols_;
+        const std::size_t c = index % cols_;
+        const char plant = plants_[index];
+        auto same = [&](const int dr, const int dc) { return plant_or_outside(r + dr, c + dc) == plant; };
+
+        RegionStats terms{plant, 1, 0, 0};
+        for (int d = 0; d < 4; ++d) terms.perimeter += !same(kDr[d], kDc[d]);
 
-        for (const auto& p : region.cells)
+        // Diagonal directions: (-1,-1), (-1,1), (1,-1), (1,1)
+        for (const int dr : {-1, 1})
         {
-            for (int i = 0; i < 4; ++i)
+            for (const int dc : {-1, 1})
             {
-                Point next{p.r + dr[i], p.c + dc[i]};
-                if (!is_in_bounds(next, grid) || !region.cell_set.contains(next))
+                const bool vertical = same(dr, 0);
+                const bool horizontal = same(0, dc);
+                if ((!vertical && !horizontal) || (vertical && horizontal && !same(dr, dc))) ++terms.sides;
+            }
+        }
+        return terms;
+    }
+
+    void GardenIndex::add_terms(const std::uint32_t region, const RegionStats& terms, const int sign)
+    {
+        regions_[region].area += sign * terms.area;
+        regions_[region].perimeter += sign * terms.perimeter;
+        regions_[region].sides += sign * terms.sides;
+    }
+
+    std::uint32_t GardenIndex::new_region(const char plant)
+    {
+        std::uint32_t region;
+        if (!free_ids_.empty())
+        {
+            region = free_ids_.back();
+            free_ids_.pop_back();
+        }
+        else
+        {
+            region = static_cast<std::uint32_t>(regions_.size());
+            regions_.emplace_back();
+        }
+        regions_[region] = RegionStats{plant, 0, 0, 0};
+        ++live_regions_;
+        return region;
+    }
+
+    void GardenIndex::release_region(const std::uint32_t region)
+    {
+        regions_[region] = RegionStats{};
+        free_ids_.push_back(region);
+        --live_regions_;
+    }
+
+    void GardenIndex::relabel(const std::size_t start, const std::uint32_t from, const std::uint32_t to)
+    {
+        std::vector<std::size_t> stack{start};
+        labels_[start] = to;
+        while (!stack.empty())
+        {
+            const std::size_t index = stack.back();
+            stack.pop_back();
+            for (int d = 0; d < 4; ++d)
+            {
+                const std::size_t r = index / cols_ + kDr[d];
+                const std::size_t c = index % cols_ + kDc[d];
+                if (r >= rows_ || c >= cols_) continue;
+                if (const std::size_t next = r * cols_ + c; labels_[next] == from)
                 {
-                    result++;
+                    labels_[next] = to;
+                    stack.push_back(next);
                 }
             }
         }
-        return result;
     }
 
     /**
-     * @brief Part 2: Number of Sides (equivalent to number of corners).
+     * @brief Detects and relabels the parts a region falls into after losing a cell
      *
-     * Strategy:
-     * - A region has as many sides as it has corners (outer and inner).
-     * - For each cell, we check its 4 potential corners (NW, NE, SW, SE).
-     * - An EXTERNAL corner exists if both cardinal neighbors are NOT in the region.
-     * - An INTERNAL corner exists if both cardinal neighbors ARE in the region
-     *   BUT the diagonal neighbor is NOT.
+     * One search per remaining same-plant neighbour of the removed cell runs in
+     * lockstep; searches that meet are grouped. The work stops as soon as all
+     * groups met (no split) or all but one group are exhausted: those are the
+     * split-off parts, and the unfinished one keeps the old id. The cost is
+     * bounded by the smaller parts, not by the whole region.
      */
-    long long count_corners(const Region& region, const std::vector<std::string>& grid)
+    void GardenIndex::split_region(const std::size_t removed, const char plant, const std::vector<std::size_t>& window,
+                                   std::vector<std::uint32_t>& touched)
     {
-        long long result = 0;
-        for (const auto& p : region.cells)
+        const std::uint32_t region = labels_[removed];
+        std::vector<std::size_t> seeds;
+        for (int d = 0; d < 4; ++d)
+        {
+            const std::size_t r = removed / cols_ + kDr[d];
+            const std::size_t c = removed % cols_ + kDc[d];
+            if (plant_or_outside(r, c) == plant) seeds.push_back(r * cols_ + c);
+        }
+        if (seeds.size() < 2) return;
+
+        const std::size_t n = seeds.size();
+        std::array<std::size_t, 4> group{0, 1, 2, 3};
+        auto find = [&](std::size_t i)
         {
-            auto is_in = [&](int r, int c)
+            while (group[i] != i) i = group[i];
+            return i;
+        };
+        std::array<std::vector<std::size_t>, 4> visited;
+        std::array<std::size_t, 4> head{};
+
+        ++epoch_;
+        mark_epoch_[removed] = epoch_; // never re-enter the removed cell
+        mark_search_[removed] = 0xFF;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (mark_epoch_[seeds[i]] == epoch_)
             {
-                return region.cell_set.contains({r, c});
-            };
+                group[find(i)] = find(mark_search_[seeds[i]]);
+                continue;
+            }
+            mark_epoch_[seeds[i]] = epoch_;
+            mark_search_[seeds[i]] = static_cast<std::uint8_t>(i);
+            visited[i].push_back(seeds[i]);
+        }
 
-            //Top-left corner
-            bool n = is_in(p.r - 1, p.c);
-            bool w = is_in(p.r, p.c - 1);
-            bool nw = is_in(p.r - 1, p.c - 1);
-            if ((!n && !w) || (n && w && !nw)) result++;
+        auto group_done = [&](const std::size_t root)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                if (find(i) == root && head[i] < visited[i].size()) return false;
+            }
+            return true;
+        };
 
-            // Top-Right Corner
-            bool e = is_in(p.r, p.c + 1);
-            bool ne = is_in(p.r - 1, p.c + 1);
-            if ((!n && !e) || (n && e && !ne)) result++;
+        while (true)
+        {
+            std::size_t groups = 0;
+            std::size_t unfinished = 0;
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                if (find(i) != i) continue;
+                ++groups;
+                unfinished += !group_done(i);
+            }
+            if (groups == 1) return;
+            if (unfinished <= 1) break;
+
+            // One expansion step per unfinished search
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                if (head[i] >= visited[i].size()) continue;
+                const std::size_t index = visited[i][head[i]++];
+                for (int d = 0; d < 4; ++d)
+                {
+                    const std::size_t r = index / cols_ + kDr[d];
+                    const std::size_t c = index % cols_ + kDc[d];
+                    if (plant_or_outside(r, c) != plant) continue;
+                    const std::size_t next = r * cols_ + c;
+                    if (mark_epoch_[next] == epoch_)
+                    {
+                        if (mark_search_[next] != 0xFF) group[find(i)] = find(mark_search_[next]);
+                        continue;
+                    }
+                    mark_epoch_[next] = epoch_;
+                    mark_search_[next] = static_cast<std::uint8_t>(i);
+                    visited[i].push_back(next);
+                }
+            }
+        }
 
-            // Bottom-Left Corner
-            bool s = is_in(p.r + 1, p.c);
-            bool sw = is_in(p.r + 1, p.c - 1);
-            if ((!s && !w) || (s && w && !sw)) result++;
+        // Every finished group is a separate part; the unfinished one (if any,
+        // otherwise the first) keeps the old id
+        std::size_t keeper = n;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (find(i) == i && !group_done(i)) keeper = i;
+        }
+        if (keeper == n) keeper = find(0);
 
-            // Bottom-Right Corner
-            bool se = is_in(p.r + 1, p.c + 1);
-            if ((!s && !e) || (s && e && !se)) result++;
+        for (std::size_t root = 0; root < n; ++root)
+        {
+            if (find(root) != root || root == keeper) continue;
+            const std::uint32_t part = new_region(plant);
+            touched.push_back(part);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                if (find(i) != root) continue;
+                for (const std::size_t index : visited[i])
+                {
+                    labels_[index] = part;
+                    // Window cells' terms are already withdrawn and get re-added later
+                    if (std::ranges::find(window, index) != window.end()) continue;
+                    const RegionStats terms = cell_terms(index);
+                    add_terms(region, terms, -1);
+                    add_terms(part, terms, 1);
+                }
+            }
         }
-        return result;
     }
 
-    /**
-     * @brief Main logic for both parts.
-     *
-     * 1. Initialize `total_price = 0` and a `visited` 2D array.
-     * 2. Iterate through every cell (r, c) in the grid:
-     *    a. If (r, c) is already visited, skip.
-     *    b. Else, call find_region() to get the new Region.
-     *    c. Calculate Area (region.cells.size()) and Perimeter/Corners.
-     *    d. Add (Area * Metric) to total_price.
-     */
-    std::string solve_part1(const std::vector<std::string>& input)
+    void GardenIndex::set_plant(const std::size_t row, const std::size_t col, const char plant)
     {
-        long long result = 0;
-        std::vector<std::vector<bool>> visited(input.size(), std::vector<bool>(input[0].size(), false));
-        for (size_t r = 0; r < input.size(); ++r)
+        if (row >= rows_ || col >= cols_) throw std::out_of_range("Cell outside the garden map");
+        const std::size_t center = row * cols_ + col;
+        const char old_plant = plants_[center];
+        if (old_plant == plant) return;
+
+        // 1. Withdraw the prices of every region in the 3x3 window and the
+        //    window cells' terms (those are the only terms that change)
+        std::vector<std::size_t> window;
+        std::vector<std::uint32_t> touched;
+        for (int dr = -1; dr <= 1; ++dr)
         {
-            const auto& line = input[r];
-            for (size_t c = 0; c < line.size(); ++c)
+            for (int dc = -1; dc <= 1; ++dc)
             {
-                if (visited[r][c])
+                const std::size_t r = row + dr;
+                const std::size_t c = col + dc;
+                if (r >= rows_ || c >= cols_) continue;
+                window.push_back(r * cols_ + c);
+                const std::uint32_t region = labels_[r * cols_ + c];
+                if (std::ranges::find(touched, region) == touched.end())
                 {
-                    continue;
+                    touched.push_back(region);
+                    perimeter_price_ -= price_of(regions_[region], false);
+                    sides_price_ -= price_of(regions_[region], true);
                 }
-                auto region = find_region(static_cast<int>(r), static_cast<int>(c), input, visited);
-                auto perimeter = calculate_perimeter(region, input);
-                result += region.cells.size() * perimeter;
             }
         }
+        for (const std::size_t index : window) add_terms(labels_[index], cell_terms(index), -1);
+
+        // 2. Take the cell out of its old region, which may split
+        const std::uint32_t old_region = labels_[center];
+        plants_[center] = plant;
+        split_region(center, old_plant, window, touched);
+        if (regions_[old_region].area == 0)
+        {
+            // Nothing left outside the window: the id is empty only if no
+            // window cell still carries it
+            bool used = false;
+            for (const std::size_t index : window)
+            {
+                used |= index != center && labels_[index] == old_region;
+            }
+            if (!used) release_region(old_region);
+        }
+
+        // 3. Join the neighbouring regions of the new plant into the largest
+        std::array<std::size_t, 4> joining{};
+        std::size_t joining_count = 0;
+        for (int d = 0; d < 4; ++d)
+        {
+            const std::size_t r = row + kDr[d];
+            const std::size_t c = col + kDc[d];
+            if (plant_or_outside(r, c) != plant) continue;
+            const std::size_t next = r * cols_ + c;
+            if (std::ranges::none_of(joining.begin(), joining.begin() + joining_count,
+                                     [&](const std::size_t cell) { return labels_[cell] == labels_[next]; }))
+            {
+                joining[joining_count++] = next;
+            }
+        }
+
+        std::uint32_t target;
+        if (joining_count == 0)
+        {
+            target = new_region(plant);
+            touched.push_back(target);
+        }
+        else
+        {
+            const auto largest = std::ranges::max_element(
+                joining.begin(), joining.begin() + joining_count,
+                [&](const std::size_t a, const std::size_t b)
+                { return regions_[labels_[a]].area < regions_[labels_[b]].area; });
+            target = labels_[*largest];
+            for (std::size_t i = 0; i < joining_count; ++i)
+            {
+                const std::uint32_t absorbed = labels_[joining[i]];
+                if (absorbed == target) continue;
+                relabel(joining[i], absorbed, target);
+                add_terms(target, regions_[absorbed], 1);
+                release_region(absorbed);
+            }
+        }
+        labels_[center] = target;
+
+        // 4. Re-add the window's terms and the touched regions' prices
+        for (const std::size_t index : window) add_terms(labels_[index], cell_terms(index), 1);
+        std::ranges::sort(touched);
+        const auto [first, last] = std::ranges::unique(touched);
+        touched.erase(first, last);
+        for (const std::uint32_t region : touched)
+        {
+            perimeter_price_ += price_of(regions_[region], false);
+            sides_price_ += price_of(regions_[region], true);
+        }
+    }
+
+    char GardenIndex::plant(const std::size_t row, const std::size_t col) const
+    {
+        if (row >= rows_ || col >= cols_) throw std::out_of_range("Cell outside the garden map");
+        return plants_[row * cols_ + col];
+    }
+
+    const RegionStats& GardenIndex::region_at(const std::size_t row, const std::size_t col) const
+    {
+        if (row >= rows_ || col >= cols_) throw std::out_of_range("Cell outside the garden map");
+        return regions_[labels_[row * cols_ + col]];
+    }
+
+    std::size_t GardenIndex::region_count() const
+    {
+        return live_regions_;
+    }
+
+    std::int64_t GardenIndex::perimeter_price() const
+    {
+        return perimeter_price_;
+    }
+
+    std::int64_t GardenIndex::sides_price() const
+    {
+        return sides_price_;
+    }
+
+    // ============================================================================
+    // PUZZLE SOLUTIONS
+    // ============================================================================
+
+    /**
+     * @brief Part 1: Sum of area * perimeter over all regions.
+     */
+    std::string solve_part1(const std::vector<std::string>& input)
+    {
+        long long result = 0;
+        for (const auto& region : analyze_regions(input))
+        {
+            result += region.area * region.perimeter;
+        }
         return std::to_string(result);
     }
 
+    /**
+     * @brief Part 2: Sum of area * number of sides over all regions.
+     */
     std::string solve_part2(const std::vector<std::string>& input)
     {
         long long result = 0;
-        std::vector<std::vector<bool>> visited(input.size(), std::vector<bool>(input[0].size(), false));
-        for (size_t r = 0; r < input.size(); ++r)
+        for (const auto& region : analyze_regions(input))
         {
-            const auto& line = input[r];
-            for (size_t c = 0; c < line.size(); ++c)
-            {
-                if (visited[r][c])
-                {
-                    continue;
-                }
-                auto region = find_region(static_cast<int>(r), static_cast<int>(c), input, visited);
-                auto corners = count_corners(region, input);
-                result += region.cells.size() * corners;
-            }
+            result += region.area * region.sides;
         }
         return std::to_string(result);
     }
@@ -1,131 +1,262 @@
 /**
  * @file day13.cpp
  * @brief Implementation of Day 13: Claw Contraption
+ *
+ * OPTIMIZATION: Structure-of-arrays batch solving.
+ * - A hand-written integer scanner replaces std::regex for parsing.
+ * - Machines are solved in fixed-size blocks. The Cramer step is a branch-free
+ *   loop over the columns that yields a cost (or 0) per machine and records
+ *   degenerate machines (D == 0) for a scalar follow-up pass.
+ * - Products are computed in 128 bits. They do not map onto SIMD lanes, so
+ *   the block loop relies on the lack of branches rather than on vector
+ *   instructions.
  */
 
 #include "days/day13.hpp"
 
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <optional>
-#include <cstdio>
-#include <regex>
-#include <ranges>
 
 namespace aoc::day13
 {
-    struct Machine
-    {
-        long long ax, ay; // Button A movement
-        long long bx, by; // Button B movement
-        long long px, py; // Prize location
-    };
+    using aoc::utils::int128;
+
+    // ============================================================================
+    // PARSING
+    // ============================================================================
 
     /**
-     * @brief Parses the input into a list of claw machines.
-     *
-     * Tip: The input is grouped in blocks of 3 lines separated by an empty line.
-     * Use `std::sscanf(line.c_str(), "Button A: X+%lld, Y+%lld", ...)`
-     * or regular expressions to extract numbers.
+     * @brief Appends every integer in a line to `out`
      */
-    std::vector<Machine> parse_machines(const std::vector<std::string>& input)
+    void scan_integers(const std::string_view line, std::vector<std::int64_t>& out)
     {
-        std::vector<Machine> result;
-        const std::regex num_regex(R"(\d+)");
-        auto get_nums = [&](const std::string& s)
+        for (std::size_t i = 0; i < line.size();)
         {
-            std::vector<long long> nums;
-            auto begin = std::sregex_iterator(s.begin(), s.end(), num_regex);
-            for (auto it = begin; it != std::sregex_iterator(); ++it)
+            if (line[i] < '0' || line[i] > '9')
             {
-                nums.push_back(std::stoll(it->str()));
+                ++i;
+                continue;
             }
-            return nums;
-        };
-        
-        for (size_t i = 0; i + 2 < input.size(); i += 4)
+            const bool negative = i > 0 && line[i - 1] == '-';
+            std::int64_t value = 0;
+            for (; i < line.size() && line[i] >= '0' && line[i] <= '9'; ++i)
+            {
+                value = value * 10 + (line[i] - '0');
+            }
+            out.push_back(negative ? -value : value);
+        }
+    }
+
+    MachineColumns parse_machine_columns(const std::vector<std::string>& input)
+    {
+        std::vector<std::int64_t> values;
+        for (const auto& line : input) scan_integers(line, values);
+        if (values.size() % 6 != 0) throw std::runtime_error("Malformed claw machine input");
+
+        MachineColumns machines;
+        const std::size_t count = values.size() / 6;
+        for (auto* column : {&machines.ax, &machines.ay, &machines.bx, &machines.by, &machines.px, &machines.py})
+        {
+            column->reserve(count);
+        }
+        for (std::size_t i = 0; i < values.size(); i += 6)
         {
-            auto a = get_nums(input[i]);
-            auto b = get_nums(input[i + 1]);
-            auto p = get_nums(input[i + 2]);
+            machines.ax.push_back(values[i]);
+            machines.ay.push_back(values[i + 1]);
+            machines.bx.push_back(values[i + 2]);
+            machines.by.push_back(values[i + 3]);
+            machines.px.push_back(values[i + 4]);
+            machines.py.push_back(values[i + 5]);
+        }
+        return machines;
+    }
+
+    // ============================================================================
+    // DEGENERATE MACHINES (D == 0)
+    // ============================================================================
+
+    [[nodiscard]] int128 floor_div(const int128 a, const int128 b)
+    {
+        const int128 q = a / b;
+        return (a % b != 0 && ((a < 0) != (b < 0))) ? q - 1 : q;
+    }
+
+    [[nodiscard]] int128 ceil_div(const int128 a, const int128 b)
+    {
+        const int128 q = a / b;
+        return (a % b != 0 && ((a < 0) == (b < 0))) ? q + 1 : q;
+    }
 
-            result.push_back({a[0], a[1], b[0], b[1], p[0], p[1]});
+    /**
+     * @brief Extended Euclid: returns g = gcd(a, b) and x, y with a*x + b*y = g
+     */
+    [[nodiscard]] int128 extended_gcd(const int128 a, const int128 b, int128& x, int128& y)
+    {
+        if (b == 0)
+        {
+            x = a >= 0 ? 1 : -1;
+            y = 0;
+            return a >= 0 ? a : -a;
         }
-        return result;
+        int128 x1, y1;
+        const int128 g = extended_gcd(b, a % b, x1, y1);
+        x = y1;
+        y = x1 - (a / b) * y1;
+        return g;
     }
 
     /**
-     * @brief Solves for minimum tokens using Cramer's Rule.
+     * @brief Cheapest a, b in [0, limit] with a * u + b * v = w, as 3a + b
      *
-     * System of Equations:
-     * 1) a * AX + b * BX = PX
-     * 2) a * AY + b * BY = PY
-     *
-     * Cramer's Rule Formulas:
-     * - Determinant (D) = (AX * BY) - (AY * BX)
-     * - Da = (PX * BY) - (PY * BX)
-     * - Db = (AX * PY) - (AY * PX)
-     *
-     * A solution exists if D != 0, Da%D == 0, and Db%D == 0.
-     * Cost = 3*a + b
+     * All solutions are a = a0 + k * (v / g), b = b0 - k * (u / g). Each bound
+     * on a or b bounds k from one side, and the cost changes by (3v - u) / g
+     * per step of k, so the optimum is an end of the feasible k range.
      */
-    std::optional<long long> solve_machine(const Machine& m)
+    [[nodiscard]] std::optional<int128> cheapest_on_line(const int128 u, const int128 v, const int128 w,
+                                                         const int128 limit)
     {
-        // TODO: Implement Cramer's Rule with integer division checks
-        auto D = (m.ax * m.by) - (m.ay * m.bx);
-        auto Da = (m.px * m.by) - (m.py * m.bx);
-        auto Db = (m.ax * m.py) - (m.ay * m.px);
+        if (u == 0 && v == 0) return w == 0 ? std::optional<int128>{0} : std::nullopt;
+
+        int128 x, y;
+        const int128 g = extended_gcd(u, v, x, y);
+        if (w % g != 0) return std::nullopt;
+        const int128 a0 = x * (w / g);
+        const int128 b0 = y * (w / g);
+        const int128 step_a = v / g;  // a = a0 + k * step_a
+        const int128 step_b = -u / g; // b = b0 + k * step_b
+
+        std::optional<int128> k_low;
+        std::optional<int128> k_high;
+        auto tighten_low = [&](const int128 k) { k_low = k_low ? std::max(*k_low, k) : k; };
+        auto tighten_high = [&](const int128 k) { k_high = k_high ? std::min(*k_high, k) : k; };
 
-        if (D == 0 || Da % D != 0 || Db % D != 0)
+        // lo <= base + k * step <= hi
+        auto constrain = [&](const int128 base, const int128 step, const int128 lo, const int128 hi)
         {
-            return std::nullopt;
-        }
+            if (step == 0) return lo <= base && base <= hi;
+            if (step > 0)
+            {
+                tighten_low(ceil_div(lo - base, step));
+                tighten_high(floor_div(hi - base, step));
+            }
+            else
+            {
+                tighten_low(ceil_div(hi - base, step));
+                tighten_high(floor_div(lo - base, step));
+            }
+            return true;
+        };
+        if (!constrain(a0, step_a, 0, limit) || !constrain(b0, step_b, 0, limit)) return std::nullopt;
+        if (k_low && k_high && *k_low > *k_high) return std::nullopt;
 
-        auto a = Da / D;
-        auto b = Db / D;
+        // Unbounded directions only ever grow a or b, so the finite end is
+        // always the cheap one when the slope points that way
+        const int128 slope = 3 * step_a + step_b;
+        int128 k = 0;
+        if (slope > 0 || (slope == 0 && k_low)) k = k_low.value_or(0);
+        else k = k_high.value_or(k_low.value_or(0));
+        return 3 * (a0 + k * step_a) + (b0 + k * step_b);
+    }
 
-        if (a < 0 || b < 0)
+    /**
+     * @brief Minimal cost for a machine whose buttons are parallel
+     */
+    [[nodiscard]] std::optional<int128> solve_degenerate(const int128 ax, const int128 ay, const int128 bx,
+                                                         const int128 by, const int128 px, const int128 py,
+                                                         const int128 limit)
+    {
+        // The prize must lie on the common line through the origin
+        if (ax * py - ay * px != 0 || bx * py - by * px != 0) return std::nullopt;
+        if (ax == 0 && ay == 0 && bx == 0 && by == 0)
         {
-            return std::nullopt;
+            return (px == 0 && py == 0) ? std::optional<int128>{0} : std::nullopt;
         }
 
-        return 3 * a + b;
+        // Everything is collinear, so one non-zero axis decides the system
+        if (ax != 0 || bx != 0) return cheapest_on_line(ax, bx, px, limit);
+        return cheapest_on_line(ay, by, py, limit);
     }
 
-    std::string solve_part1(const std::vector<std::string>& input)
+    // ============================================================================
+    // BATCH SOLVER
+    // ============================================================================
+
+    int128 total_min_tokens(const MachineColumns& machines, const std::int64_t prize_offset,
+                            const std::int64_t max_presses)
     {
-        long long result = 0;
-        // 1. Parse machines
-        auto machines = parse_machines(input);
-        // 2. Solve each machine
-        for (const auto& machine : machines)
+        constexpr std::size_t kBlock = 64;
+        std::array<int128, kBlock> costs{};
+        std::array<std::uint32_t, kBlock> degenerate{};
+
+        int128 total = 0;
+        for (std::size_t begin = 0; begin < machines.size(); begin += kBlock)
         {
-            result += solve_machine(machine).value_or(0);
+            const std::size_t end = std::min(machines.size(), begin + kBlock);
+            std::size_t degenerate_count = 0;
+
+            // Cramer's rule for the whole block; invalid machines cost 0
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                const int128 ax = machines.ax[i];
+                const int128 ay = machines.ay[i];
+                const int128 bx = machines.bx[i];
+                const int128 by = machines.by[i];
+                const int128 px = int128{machines.px[i]} + prize_offset;
+                const int128 py = int128{machines.py[i]} + prize_offset;
+
+                const int128 d = ax * by - ay * bx;
+                const int128 da = px * by - py * bx;
+                const int128 db = ax * py - ay * px;
+                const int128 safe_d = d == 0 ? 1 : d;
+                const int128 a = da / safe_d;
+                const int128 b = db / safe_d;
+                const bool valid = d != 0 && da % safe_d == 0 && db % safe_d == 0 && a >= 0 && b >= 0 &&
+                    a <= max_presses && b <= max_presses;
+
+                costs[i - begin] = valid ? 3 * a + b : 0;
+                degenerate[degenerate_count] = static_cast<std::uint32_t>(i);
+                degenerate_count += d == 0;
+            }
+
+            for (std::size_t i = 0; i < end - begin; ++i) total += costs[i];
+
+            for (std::size_t j = 0; j < degenerate_count; ++j)
+            {
+                const std::size_t i = degenerate[j];
+                total += solve_degenerate(machines.ax[i], machines.ay[i], machines.bx[i], machines.by[i],
+                                          int128{machines.px[i]} + prize_offset,
+                                          int128{machines.py[i]} + prize_offset, max_presses)
+                             .value_or(0);
+            }
         }
-        // 3. Sum costs
-        return std::to_string(result);
+        return total;
+    }
+
+    // ============================================================================
+    // PUZZLE SOLUTIONS
+    // ============================================================================
+
+    /**
+     * @brief Part 1: At most 100 presses per button.
+     */
+    std::string solve_part1(const std::vector<std::string>& input)
+    {
+        return aoc::utils::to_string(total_min_tokens(parse_machine_columns(input), 0, 100));
     }
 
     /**
      * @brief Part 2: Large Prize Coordinates.
      *
-     * Important:
-     * - Add 10,000,000,000,000 to both `px` and `py` for each machine.
-     * - Use `long long` for all calculations to prevent overflow.
+     * Both prize coordinates are 10,000,000,000,000 further away; there is no
+     * press limit.
      */
     std::string solve_part2(const std::vector<std::string>& input)
     {
-        // 1. Parse machines
-        long long result = 0;
-        auto machines = parse_machines(input);
-        // 2. Apply offset to prize coordinates
-        for (auto& machine : machines)
-        {
-            machine.px += 10000000000000ll;
-            machine.py += 10000000000000ll;
-            result += solve_machine(machine).value_or(0);
-        }
-        // 3. Solve and sum
-        return std::to_string(result);
+        return aoc::utils::to_string(total_min_tokens(parse_machine_columns(input), 10000000000000LL));
     }
 } // namespace aoc::day13
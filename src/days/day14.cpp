@@ -21,11 +21,23 @@
  *
  * What is the fewest number of seconds that must elapse for the robots to 
  * display the Christmas tree?
+ *
+ * OPTIMIZATION: The axes are independent and periodic, so instead of
+ * scoring all width * height frames, the tightest x phase (width steps) and
+ * y phase (height steps) are combined with the Chinese remainder theorem.
+ *
+ * FRAME SEARCH: For pictures that are not simply "tightest cluster", frames
+ * can also be scored by pluggable metrics over a bit-packed occupancy map
+ * (longest row run, neighbour adjacency, block entropy) and scanned on worker
+ * threads that stop as soon as the earliest hit is certain.
  */
 
 #include "days/day14.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -34,6 +46,10 @@
 #include <array>
 #include <regex>
 #include <limits>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <utility>
 
 namespace aoc::day14
 {
@@ -110,52 +126,388 @@ namespace aoc::day14
         return std::ranges::fold_left(quadrants, 1LL, std::multiplies<>());
     }
 
+    // ============================================================================
+    // STRUCTURE-OF-ARRAYS SWARM
+    // ============================================================================
+
+    RobotSwarm::RobotSwarm(const std::vector<Robot>& robots, const int width, const int height)
+        : width_(width), height_(height)
+    {
+        xs_.reserve(robots.size());
+        ys_.reserve(robots.size());
+        vxs_.reserve(robots.size());
+        vys_.reserve(robots.size());
+        for (const auto& robot : robots)
+        {
+            xs_.push_back((robot.px % width + width) % width);
+            ys_.push_back((robot.py % height + height) % height);
+            vxs_.push_back((robot.vx % width + width) % width);
+            vys_.push_back((robot.vy % height + height) % height);
+        }
+    }
+
+    void RobotSwarm::step_axis(std::vector<std::int32_t>& positions, const std::vector<std::int32_t>& steps,
+                               const std::int32_t size)
+    {
+        std::int32_t* __restrict p = positions.data();
+        const std::int32_t* __restrict v = steps.data();
+        const std::size_t n = positions.size();
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            // Both operands are in [0, size), so one conditional subtract wraps
+            const std::int32_t moved = p[i] + v[i];
+            p[i] = moved - (moved >= size ? size : 0);
+        }
+    }
+
+    void RobotSwarm::advance(const long long seconds)
+    {
+        if (seconds == 1)
+        {
+            step_axis(xs_, vxs_, width_);
+            step_axis(ys_, vys_, height_);
+            return;
+        }
+
+        // A longer jump is one step with velocity * seconds reduced per axis
+        const auto sx = static_cast<std::int64_t>(seconds % width_);
+        const auto sy = static_cast<std::int64_t>(seconds % height_);
+        jump_x_.resize(xs_.size());
+        jump_y_.resize(ys_.size());
+        for (std::size_t i = 0; i < xs_.size(); ++i)
+        {
+            jump_x_[i] = static_cast<std::int32_t>(vxs_[i] * sx % width_);
+            jump_y_[i] = static_cast<std::int32_t>(vys_[i] * sy % height_);
+        }
+        step_axis(xs_, jump_x_, width_);
+        step_axis(ys_, jump_y_, height_);
+    }
+
+    std::array<std::size_t, 4> RobotSwarm::quadrant_counts() const
+    {
+        const std::int32_t mid_x = width_ / 2;
+        const std::int32_t mid_y = height_ / 2;
+        const std::int32_t* __restrict x = xs_.data();
+        const std::int32_t* __restrict y = ys_.data();
+
+        // Comparisons yield 0/1 lanes; 32-bit partial sums keep the loop in
+        // vector registers and are flushed before they could overflow
+        constexpr std::size_t kChunk = std::size_t{1} << 30;
+        std::array<std::size_t, 4> counts{};
+        for (std::size_t begin = 0; begin < xs_.size(); begin += kChunk)
+        {
+            const std::size_t end = std::min(xs_.size(), begin + kChunk);
+            std::uint32_t top_left = 0, top_right = 0, bottom_left = 0, bottom_right = 0;
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                const std::uint32_t left = x[i] < mid_x;
+                const std::uint32_t right = x[i] > mid_x;
+                const std::uint32_t top = y[i] < mid_y;
+                const std::uint32_t bottom = y[i] > mid_y;
+                top_left += left & top;
+                top_right += right & top;
+                bottom_left += left & bottom;
+                bottom_right += right & bottom;
+            }
+            counts[0] += top_left;
+            counts[1] += top_right;
+            counts[2] += bottom_left;
+            counts[3] += bottom_right;
+        }
+        return counts;
+    }
+
+    long long RobotSwarm::safety_factor() const
+    {
+        long long product = 1;
+        for (const auto count : quadrant_counts()) product *= static_cast<long long>(count);
+        return product;
+    }
+
+    /**
+     * @brief Part 1: Safety factor after 100 seconds.
+     */
     std::string solve_part1(const std::vector<std::string>& input)
     {
         const int width = 101;
         const int height = 103;
 
-        // 1. Parse all robots.
-        const auto robots = parse_input(input);
-        // 2. For each robot, simulate its position at T=100.
-        std::vector<std::pair<int, int>> positions{};
-        for (auto robot : robots)
+        RobotSwarm swarm(parse_input(input), width, height);
+        swarm.advance(100);
+        return std::to_string(swarm.safety_factor());
+    }
+
+    // ============================================================================
+    // CLUSTER SEARCH (CRT)
+    // ============================================================================
+
+    /**
+     * @brief Scaled variance n * sum(x^2) - (sum x)^2 of one axis for each phase
+     * @param positions Coordinates at time 0 (in [0, period))
+     * @param velocities Per-second steps, already reduced into [0, period)
+     * @param period Size of the axis
+     * @return Spread for every t in [0, period)
+     */
+    std::vector<long long> axis_spread(std::vector<std::int32_t> positions, const std::vector<std::int32_t>& velocities,
+                                       const int period)
+    {
+        const auto n = static_cast<long long>(positions.size());
+        std::vector<long long> spread(period);
+        for (int t = 0; t < period; ++t)
         {
-            auto position = simulate_movement(robot, 100, width, height);
-            positions.push_back(position);
+            long long sum = 0;
+            long long sum_sq = 0;
+            for (const std::int32_t position : positions)
+            {
+                sum += position;
+                sum_sq += static_cast<long long>(position) * position;
+            }
+            spread[t] = n * sum_sq - sum * sum;
+            RobotSwarm::step_axis(positions, velocities, period);
         }
-        // 3. Collect all positions and pass to calculate_safety_factor.
-        const auto result = calculate_safety_factor(positions, width, height);
+        return spread;
+    }
 
-        return std::to_string(result);
+    /**
+     * @brief Solves t = a (mod m), t = b (mod n); returns -1 if inconsistent
+     */
+    long long crt_combine(const long long a, const long long m, const long long b, const long long n)
+    {
+        // t = a + m * k with m * k = b - a (mod n)
+        long long x = 1, y = 0, x1 = 0, y1 = 1, r = m, r1 = n;
+        while (r1 != 0)
+        {
+            const long long q = r / r1;
+            std::tie(r, r1) = std::pair{r1, r - q * r1};
+            std::tie(x, x1) = std::pair{x1, x - q * x1};
+            std::tie(y, y1) = std::pair{y1, y - q * y1};
+        }
+        const long long g = r; // m * x + n * y = g
+        if ((b - a) % g != 0) return -1;
+
+        const long long step = n / g;
+        const long long k = ((b - a) / g % step * (x % step)) % step;
+        const long long lcm = m / g * n;
+        return ((a + m * k) % lcm + lcm) % lcm;
     }
 
-    std::string solve_part2(const std::vector<std::string>& input)
+    long long find_cluster_time(const std::vector<Robot>& robots, const int width, const int height)
     {
-        const int width = 101;
-        const int height = 103;
-        const auto robots = parse_input(input);
+        const RobotSwarm swarm(robots, width, height);
+        const auto x_spread = axis_spread(swarm.xs(), swarm.x_velocities(), width);
+        const auto y_spread = axis_spread(swarm.ys(), swarm.y_velocities(), height);
+        const auto best_x = static_cast<int>(std::ranges::min_element(x_spread) - x_spread.begin());
+        const auto best_y = static_cast<int>(std::ranges::min_element(y_spread) - y_spread.begin());
+
+        if (const long long t = crt_combine(best_x, width, best_y, height); t >= 0)
+        {
+            return t;
+        }
+
+        // Non-coprime sizes with disagreeing phases: keep the x phase and take
+        // the candidate whose y phase is tightest
+        const long long lcm = std::lcm(static_cast<long long>(width), static_cast<long long>(height));
+        long long best_time = best_x;
+        for (long long t = best_x; t < lcm; t += width)
+        {
+            if (y_spread[t % height] < y_spread[best_time % height]) best_time = t;
+        }
+        return best_time;
+    }
+
+    // ============================================================================
+    // FRAME METRICS
+    // ============================================================================
+
+    OccupancyFrame::OccupancyFrame(const int width, const int height)
+        : width_(width), height_(height), words_per_row_((static_cast<std::size_t>(width) + 63) / 64),
+          bits_(words_per_row_ * height, 0)
+    {
+    }
+
+    void OccupancyFrame::load(const RobotSwarm& swarm)
+    {
+        std::ranges::fill(bits_, 0);
+        const auto& xs = swarm.xs();
+        const auto& ys = swarm.ys();
+        for (std::size_t i = 0; i < xs.size(); ++i)
+        {
+            bits_[ys[i] * words_per_row_ + xs[i] / 64] |= std::uint64_t{1} << (xs[i] % 64);
+        }
+    }
 
-        long long lowest_sf = std::numeric_limits<long long>::max();
-        int best_time = 0;
+    bool OccupancyFrame::occupied(const int x, const int y) const
+    {
+        return (row(y)[x / 64] >> (x % 64)) & 1;
+    }
 
-        for (int t = 1; t <= width * height; ++t)
+    FrameMetric longest_row_run_metric()
+    {
+        return [](const OccupancyFrame& frame)
         {
-            std::vector<std::pair<int, int>> positions;
-            positions.reserve(robots.size());
-            for (const auto& robot : robots)
+            int longest = 0;
+            for (int y = 0; y < frame.height(); ++y)
             {
-                positions.push_back(simulate_movement(robot, t, width, height));
+                const std::uint64_t* words = frame.row(y);
+                int run = 0; // run reaching into the current word from the left
+                for (std::size_t w = 0; w < frame.words_per_row(); ++w)
+                {
+                    const std::uint64_t word = words[w];
+                    if (word == ~std::uint64_t{0})
+                    {
+                        run += 64;
+                        continue;
+                    }
+                    longest = std::max(longest, run + std::countr_one(word));
+
+                    // Longest run inside the word: each AND with a shifted copy
+                    // shortens every run by one
+                    int inside = 0;
+                    for (std::uint64_t rest = word; rest != 0; rest &= rest >> 1) ++inside;
+                    longest = std::max(longest, inside);
+                    run = std::countl_one(word);
+                }
+                longest = std::max(longest, run);
             }
+            return static_cast<double>(longest);
+        };
+    }
 
-            auto sf = calculate_safety_factor(positions, width, height);
-            if (sf < lowest_sf)
+    FrameMetric adjacency_metric()
+    {
+        return [](const OccupancyFrame& frame)
+        {
+            long long pairs = 0;
+            const std::size_t words = frame.words_per_row();
+            for (int y = 0; y < frame.height(); ++y)
             {
-                lowest_sf = sf;
-                best_time = t;
+                const std::uint64_t* current = frame.row(y);
+                const std::uint64_t* below = y + 1 < frame.height() ? frame.row(y + 1) : nullptr;
+                for (std::size_t w = 0; w < words; ++w)
+                {
+                    // Right neighbours: shift the row left by one cell across words
+                    const std::uint64_t carry = w + 1 < words ? current[w + 1] << 63 : 0;
+                    const std::uint64_t right = (current[w] >> 1) | carry;
+                    std::uint64_t touching = current[w] & right;
+                    if (below != nullptr) touching |= current[w] & below[w];
+                    pairs += std::popcount(touching);
+                }
             }
+            return static_cast<double>(pairs);
+        };
+    }
+
+    /**
+     * @brief Occupied cells of one frame row in columns [begin, end)
+     */
+    int count_row_range(const std::uint64_t* words, int begin, const int end)
+    {
+        int count = 0;
+        while (begin < end)
+        {
+            const int offset = begin % 64;
+            const int take = std::min(64 - offset, end - begin);
+            const std::uint64_t mask = (take == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << take) - 1) << offset;
+            count += std::popcount(words[begin / 64] & mask);
+            begin += take;
         }
+        return count;
+    }
+
+    FrameMetric block_entropy_metric(const int tile)
+    {
+        if (tile <= 0) throw std::invalid_argument("Block size must be positive");
 
-        return std::to_string(best_time);
+        return [tile](const OccupancyFrame& frame)
+        {
+            const int blocks_x = (frame.width() + tile - 1) / tile;
+            const int blocks_y = (frame.height() + tile - 1) / tile;
+            std::vector<int> counts(static_cast<std::size_t>(blocks_x) * blocks_y, 0);
+            int total = 0;
+            for (int y = 0; y < frame.height(); ++y)
+            {
+                const std::uint64_t* words = frame.row(y);
+                int* block_row = counts.data() + static_cast<std::size_t>(y / tile) * blocks_x;
+                for (int bx = 0; bx < blocks_x; ++bx)
+                {
+                    const int cells = count_row_range(words, bx * tile, std::min(frame.width(), (bx + 1) * tile));
+                    block_row[bx] += cells;
+                    total += cells;
+                }
+            }
+            if (total == 0) return 0.0;
+
+            double entropy = 0.0;
+            for (const int count : counts)
+            {
+                if (count == 0) continue;
+                const double p = static_cast<double>(count) / total;
+                entropy -= p * std::log2(p);
+            }
+            return std::log2(static_cast<double>(counts.size())) - entropy;
+        };
+    }
+
+    std::optional<int> find_first_frame(const std::vector<Robot>& robots, const int width, const int height,
+                                        const FrameMetric& metric, const double threshold, const int max_time,
+                                        unsigned thread_count)
+    {
+        constexpr int kFramesPerClaim = 64;
+        std::atomic<int> next_start{0};
+        std::atomic<int> first_hit{max_time};
+
+        auto worker = [&]
+        {
+            RobotSwarm swarm(robots, width, height);
+            OccupancyFrame frame(width, height);
+            int swarm_time = 0;
+            for (int start = next_start.fetch_add(kFramesPerClaim); start < first_hit.load();
+                 start = next_start.fetch_add(kFramesPerClaim))
+            {
+                swarm.advance(start - swarm_time);
+                swarm_time = start;
+                const int end = std::min(start + kFramesPerClaim, max_time);
+                for (int t = start; t < end && t < first_hit.load(std::memory_order_relaxed); ++t)
+                {
+                    if (t > swarm_time)
+                    {
+                        swarm.advance();
+                        swarm_time = t;
+                    }
+                    frame.load(swarm);
+                    if (metric(frame) < threshold) continue;
+
+                    // Keep the smallest hit; later frames in this claim cannot beat it
+                    int known = first_hit.load();
+                    while (t < known && !first_hit.compare_exchange_weak(known, t))
+                    {
+                    }
+                    break;
+                }
+            }
+        };
+
+        if (thread_count == 0) thread_count = std::max(1u, std::thread::hardware_concurrency());
+        {
+            std::vector<std::jthread> workers;
+            workers.reserve(thread_count);
+            for (unsigned t = 0; t < thread_count; ++t)
+            {
+                workers.emplace_back(worker);
+            }
+        }
+
+        const int hit = first_hit.load();
+        return hit < max_time ? std::optional<int>{hit} : std::nullopt;
+    }
+
+    /**
+     * @brief Part 2: The picture is the moment both axes are most clustered.
+     */
+    std::string solve_part2(const std::vector<std::string>& input)
+    {
+        const int width = 101;
+        const int height = 103;
+        return std::to_string(find_cluster_time(parse_input(input), width, height));
     }
 } // namespace aoc::day14
@@ -7,17 +7,35 @@
  * - std::optional<Direction> for safe direction parsing
  * - std::pair<Warehouse, std::string> for separating map from instructions
  * - std::set<Position> for tracking boxes to move (Part 2 chain detection)
+ *
+ * OPTIMIZATION: FlatWarehouse keeps the map in one contiguous buffer.
+ * - Horizontal pushes shift the run [robot, first free cell) with memmove.
+ * - Vertical pushes collect boxes with a reusable stack and epoch-stamped
+ *   visited marks instead of a std::queue and std::set per move.
+ *
+ * STREAMING: simulate_stream() never materialises the instruction string; it
+ * reads the file through a fixed-size ChunkedFileReader buffer.
+ *
+ * UNDO: After checkpoint() every overwritten cell is journaled with its old
+ * value and each move records the robot and GPS sum, so rollback() restores
+ * a branch in time proportional to what it changed.
  */
 
 #include "days/day15.hpp"
 
+#include "utils/input_handler.hpp"
+
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <numeric>
 #include <queue>
 #include <ranges>
 #include <set>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace aoc::day15
@@ -164,8 +182,12 @@ namespace aoc::day15
 
             if (warehouse.grid[scan.y][scan.x] == '.')
             {
-                warehouse.grid[scan.y].erase(scan.x, 1);
-                warehouse.grid[scan.y].insert(warehouse.robot_pos.x, 1, '.');
+                // Shift the run [robot, scan) one cell towards scan, robot included
+                auto& row = warehouse.grid[scan.y];
+                const int robot_x = warehouse.robot_pos.x;
+                if (delta.x > 0) std::memmove(&row[robot_x + 1], &row[robot_x], scan.x - robot_x);
+                else std::memmove(&row[scan.x], &row[scan.x + 1], robot_x - scan.x);
+                row[robot_x] = '.';
                 warehouse.robot_pos += delta;
                 return true;
             }
@@ -272,43 +294,309 @@ namespace aoc::day15
         return result;
     }
 
-    std::string solve_part1(const std::vector<std::string>& input)
+    // ============================================================================
+    // FLAT WAREHOUSE
+    // ============================================================================
+
+    FlatWarehouse::FlatWarehouse(const Warehouse& warehouse)
+        : width_(warehouse.width), height_(warehouse.height),
+          cells_(static_cast<std::size_t>(warehouse.width) * warehouse.height, '#'),
+          robot_(warehouse.robot_pos.y * warehouse.width + warehouse.robot_pos.x),
+          visited_epoch_(cells_.size(), 0)
     {
-        // TODO: Orchestrate Part 1 solution.
-        //
-        auto [warehouse, instructions] = parse_input(input);
-        // 1. {warehouse, instructions} = parse_input(input).
-        // 2. For each char in instructions:
-        for (char c : instructions)
+        for (int y = 0; y < height_; ++y)
         {
-            if (auto dir = char_to_direction(c))
+            const auto& row = warehouse.grid[y];
+            std::copy_n(row.begin(), std::min<std::size_t>(row.size(), width_), cells_.begin() + y * width_);
+        }
+        cells_[robot_] = '@';
+
+        for (int index = 0; index < static_cast<int>(cells_.size()); ++index)
+        {
+            if (cells_[index] == 'O' || cells_[index] == '[')
             {
-                try_move_part1(warehouse, dir.value());
+                gps_ += 100LL * (index / width_) + index % width_;
             }
         }
-        //    - if (dir = char_to_direction(char)) try_move_part1(warehouse, *dir).
-        // 3. return std::to_string(calculate_gps_sum(warehouse)).
-        return std::to_string(calculate_gps_sum(warehouse));
     }
 
-    std::string solve_part2(const std::vector<std::string>& input)
+    void FlatWarehouse::record_move()
+    {
+        if (journaling_) moves_.push_back(MoveRecord{journal_.size(), robot_, gps_});
+    }
+
+    void FlatWarehouse::journal(const int cell)
+    {
+        if (journaling_) journal_.push_back(JournalEntry{cell, cells_[cell]});
+    }
+
+    bool FlatWarehouse::move(const Direction dir)
+    {
+        switch (dir)
+        {
+        case Direction::Left: return push_horizontal(-1);
+        case Direction::Right: return push_horizontal(1);
+        case Direction::Up: return push_vertical(-width_);
+        case Direction::Down: return push_vertical(width_);
+        }
+        return false;
+    }
+
+    bool FlatWarehouse::push_horizontal(const int step)
+    {
+        int scan = robot_ + step;
+        while (cells_[scan] == 'O' || cells_[scan] == '[' || cells_[scan] == ']') scan += step;
+        if (cells_[scan] != '.') return false;
+
+        record_move();
+        const int low = std::min(robot_, scan);
+        const int high = std::max(robot_, scan);
+        for (int cell = low; cell <= high; ++cell)
+        {
+            journal(cell);
+            gps_ += (cells_[cell] == 'O' || cells_[cell] == '[') ? step : 0;
+        }
+
+        // Slide the run [robot, scan) one cell towards scan; '@' moves with it
+        if (step > 0) std::memmove(&cells_[robot_ + 1], &cells_[robot_], scan - robot_);
+        else std::memmove(&cells_[scan], &cells_[scan + 1], robot_ - scan);
+        cells_[robot_] = '.';
+        robot_ += step;
+        return true;
+    }
+
+    bool FlatWarehouse::push_vertical(const int step)
+    {
+        const int target = robot_ + step;
+        if (cells_[target] == '#') return false;
+        if (cells_[target] != '.')
+        {
+            if (++epoch_ == 0)
+            {
+                std::ranges::fill(visited_epoch_, 0);
+                epoch_ = 1;
+            }
+            stack_.clear();
+            pushed_.clear();
+            stack_.push_back(target);
+            visited_epoch_[target] = epoch_;
+
+            while (!stack_.empty())
+            {
+                const int cell = stack_.back();
+                stack_.pop_back();
+                const char tile = cells_[cell];
+                if (tile == '#') return false;
+                if (tile == '.') continue;
+
+                pushed_.push_back(cell);
+                auto visit = [&](const int next)
+                {
+                    if (visited_epoch_[next] == epoch_) return;
+                    visited_epoch_[next] = epoch_;
+                    stack_.push_back(next);
+                };
+                visit(cell + step);
+                if (tile == '[') visit(cell + 1);
+                else if (tile == ']') visit(cell - 1);
+            }
+
+            // Lift every pushed tile, then drop it one row further
+            record_move();
+            for (const int cell : pushed_)
+            {
+                journal(cell);
+                journal(cell + step);
+            }
+            pushed_tiles_.clear();
+            for (const int cell : pushed_)
+            {
+                pushed_tiles_.push_back(cells_[cell]);
+                if (cells_[cell] == 'O' || cells_[cell] == '[') gps_ += step > 0 ? 100 : -100;
+                cells_[cell] = '.';
+            }
+            for (std::size_t i = 0; i < pushed_.size(); ++i)
+            {
+                cells_[pushed_[i] + step] = pushed_tiles_[i];
+            }
+        }
+        else
+        {
+            record_move();
+        }
+
+        journal(robot_);
+        journal(target);
+        cells_[robot_] = '.';
+        robot_ = target;
+        cells_[robot_] = '@';
+        return true;
+    }
+
+    long long FlatWarehouse::gps_sum() const
+    {
+        return gps_;
+    }
+
+    void FlatWarehouse::apply(const std::string_view plan)
+    {
+        for (const char c : plan)
+        {
+            if (const auto dir = char_to_direction(c)) move(*dir);
+        }
+    }
+
+    FlatWarehouse::Mark FlatWarehouse::checkpoint()
     {
-        // TODO: Orchestrate Part 2 solution.
-        // 
-        // 1. {raw_warehouse, instructions} = parse_input(input).
-        auto [raw_warehouse, instructions] = parse_input(input);
-        // 2. warehouse = expand_warehouse(raw_warehouse).
-        auto warehouse = expand_warehouse(raw_warehouse);
-        // 3. For each char in instructions:
-        for (char c : instructions)
+        journaling_ = true;
+        return moves_.size();
+    }
+
+    void FlatWarehouse::rollback(const Mark mark)
+    {
+        while (moves_.size() > mark)
+        {
+            const MoveRecord& record = moves_.back();
+            // Undo in reverse so cells written twice end with their oldest value
+            while (journal_.size() > record.first_entry)
+            {
+                cells_[journal_.back().cell] = journal_.back().previous;
+                journal_.pop_back();
+            }
+            robot_ = record.robot;
+            gps_ = record.gps;
+            moves_.pop_back();
+        }
+    }
+
+    void FlatWarehouse::clear_journal()
+    {
+        journaling_ = false;
+        journal_.clear();
+        moves_.clear();
+    }
+
+    Position FlatWarehouse::robot() const
+    {
+        return {robot_ % width_, robot_ / width_};
+    }
+
+    char FlatWarehouse::at(const Position pos) const
+    {
+        return cells_[pos.y * width_ + pos.x];
+    }
+
+    Warehouse FlatWarehouse::to_warehouse() const
+    {
+        Warehouse result;
+        result.width = width_;
+        result.height = height_;
+        result.robot_pos = robot();
+        for (int y = 0; y < height_; ++y)
+        {
+            result.grid.emplace_back(cells_.begin() + y * width_, cells_.begin() + (y + 1) * width_);
+        }
+        return result;
+    }
+
+    // ============================================================================
+    // WHAT-IF PLANNING
+    // ============================================================================
+
+    std::vector<long long> evaluate_plans(const FlatWarehouse& start, const std::vector<std::string>& plans,
+                                          unsigned thread_count)
+    {
+        std::vector<long long> results(plans.size());
+        std::atomic<std::size_t> next_plan{0};
+
+        auto worker = [&]
+        {
+            FlatWarehouse branch = start;
+            branch.clear_journal();
+            const auto mark = branch.checkpoint();
+            for (std::size_t i = next_plan++; i < plans.size(); i = next_plan++)
+            {
+                branch.apply(plans[i]);
+                results[i] = branch.gps_sum();
+                branch.rollback(mark);
+            }
+        };
+
+        if (thread_count == 0) thread_count = std::max(1u, std::thread::hardware_concurrency());
+        const std::size_t useful = std::max<std::size_t>(plans.size(), 1);
+        thread_count = static_cast<unsigned>(std::min<std::size_t>(thread_count, useful));
+        {
+            std::vector<std::jthread> workers;
+            workers.reserve(thread_count);
+            for (unsigned t = 0; t < thread_count; ++t)
+            {
+                workers.emplace_back(worker);
+            }
+        }
+        return results;
+    }
+
+    // ============================================================================
+    // STREAMING SIMULATION
+    // ============================================================================
+
+    FlatWarehouse simulate_stream(const std::string& filepath, const bool wide, const std::uint64_t checkpoint_every,
+                                  const CheckpointSink& sink, const std::size_t chunk_size)
+    {
+        aoc::utils::ChunkedFileReader reader(filepath, chunk_size);
+
+        std::vector<std::string> map_lines;
+        std::string line;
+        while (reader.read_line(line) && !line.empty())
+        {
+            map_lines.push_back(line);
+        }
+        if (map_lines.empty()) throw std::runtime_error("Map section is empty");
+
+        const auto warehouse = parse_input(map_lines).first;
+        FlatWarehouse simulator(wide ? expand_warehouse(warehouse) : warehouse);
+
+        std::uint64_t moves = 0;
+        for (auto chunk = reader.next_chunk(); !chunk.empty(); chunk = reader.next_chunk())
         {
-            if (auto dir = char_to_direction(c))
+            for (const char c : chunk)
             {
-                try_move_part2(warehouse, dir.value());
+                const auto dir = char_to_direction(c);
+                if (!dir) continue; // newlines between instruction lines
+                simulator.move(*dir);
+                ++moves;
+                if (checkpoint_every != 0 && moves % checkpoint_every == 0 && sink)
+                {
+                    sink(WarehouseCheckpoint{moves, simulator});
+                }
             }
         }
-        //    - if (dir = char_to_direction(char)) try_move_part2(warehouse, *dir).
-        // 4. return std::to_string(calculate_gps_sum(warehouse)).
-        return std::to_string(calculate_gps_sum(warehouse));
+        return simulator;
+    }
+
+    // ============================================================================
+    // PUZZLE SOLUTIONS
+    // ============================================================================
+
+    std::string solve_part1(const std::vector<std::string>& input)
+    {
+        const auto [warehouse, instructions] = parse_input(input);
+        FlatWarehouse simulator(warehouse);
+        for (const char c : instructions)
+        {
+            if (const auto dir = char_to_direction(c)) simulator.move(*dir);
+        }
+        return std::to_string(simulator.gps_sum());
+    }
+
+    std::string solve_part2(const std::vector<std::string>& input)
+    {
+        const auto [raw_warehouse, instructions] = parse_input(input);
+        FlatWarehouse simulator(expand_warehouse(raw_warehouse));
+        for (const char c : instructions)
+        {
+            if (const auto dir = char_to_direction(c)) simulator.move(*dir);
+        }
+        return std::to_string(simulator.gps_sum());
     }
 } // namespace aoc::day15
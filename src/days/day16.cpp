@@ -1,23 +1,605 @@
 /**
  * @file day16.cpp
- * @brief Implementation of Day 16: [TODO - Beschreibung des Puzzles]
+ * @brief Day 16: Reindeer Maze - Weighted Shortest Paths with Turns
+ *
+ * C++ Toolbox:
+ * - std::vector<char> flat grid with a wall ring (no bounds checks)
+ * - std::vector<std::uint32_t> distance tables indexed by cell * 4 + heading
+ * - Template parameter to share one search loop between forward and reverse
+ *
+ * OPTIMIZATION: Dial's algorithm. Every edge costs either 1 or 1000, so all
+ * tentative distances lie in [current, current + 1000]. A ring of 1001
+ * buckets indexed by distance modulo 1001 is therefore a monotone priority
+ * queue with O(1) push and amortised O(1) pop; stale entries are skipped
+ * lazily by comparing against the distance table.
+ *
+ * PART 2: A state s is on a best path iff from_start[s] + to_end[s] == best,
+ * so one reverse search replaces any enumeration of the (exponentially many)
+ * optimal paths.
+ *
+ * CONTRACTION: solve_maze_contracted() searches the junction graph built by
+ * utils::contract_maze(). Edge weights are arbitrary there, so it uses a
+ * binary heap; an edge lies on a best path when
+ * from_start[tail] + weight + to_end[head] == best, and its tile list is
+ * then marked on the grid.
+ *
+ * PARALLELISM: solve_maze_bidirectional() runs the forward and backward
+ * bucket-queue searches on two std::jthreads sharing the best meeting cost
+ * mu and each side's current bucket. Distances are atomics written with
+ * sequentially consistent stores before the other side's entry is read, so
+ * for every state at least one side sees both values and offers their sum
+ * to mu. A side stops when top_forward + top_backward > mu: a state on a
+ * best path settled by neither side would then cost more than mu.
  */
 
 #include "days/day16.hpp"
 
+#include "utils/maze_graph.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <queue>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
-namespace aoc::day16 {
+namespace aoc::day16
+{
+    // ========================================================================
+    // MAZE
+    // ========================================================================
+
+    int Maze::step(Heading heading) const
+    {
+        switch (heading)
+        {
+        case Heading::East: return 1;
+        case Heading::South: return stride;
+        case Heading::West: return -1;
+        case Heading::North: return -stride;
+        }
+        return 0;
+    }
+
+    Maze parse_maze(const std::vector<std::string>& input)
+    {
+        std::size_t width = 0;
+        for (const auto& line : input)
+        {
+            width = std::max(width, line.size());
+        }
+
+        Maze maze;
+        maze.stride = static_cast<int>(width) + 2;
+        maze.rows = static_cast<int>(input.size()) + 2;
+        maze.open.assign(static_cast<std::size_t>(maze.stride) * maze.rows, 0);
+        maze.start = -1;
+        maze.end = -1;
+
+        for (std::size_t y = 0; y < input.size(); ++y)
+        {
+            for (std::size_t x = 0; x < input[y].size(); ++x)
+            {
+                const char c = input[y][x];
+                const int cell = static_cast<int>(y + 1) * maze.stride + static_cast<int>(x + 1);
+                if (c == '#')
+                {
+                    continue;
+                }
+                maze.open[cell] = 1;
+                if (c == 'S')
+                {
+                    maze.start = cell;
+                }
+                else if (c == 'E')
+                {
+                    maze.end = cell;
+                }
+            }
+        }
+
+        if (maze.start < 0 || maze.end < 0)
+        {
+            throw std::runtime_error("Maze needs both a start 'S' and an end 'E'");
+        }
+        return maze;
+    }
+
+    // ========================================================================
+    // BUCKET QUEUE SEARCH
+    // ========================================================================
+
+    namespace
+    {
+        /**
+         * @brief Monotone priority queue for edge weights in [0, kTurnCost]
+         *
+         * Pushed distances never exceed the last popped distance plus
+         * kTurnCost, so bucket (distance mod kBucketCount) is unambiguous.
+         */
+        class BucketQueue
+        {
+        public:
+            void push(std::uint32_t state, std::uint32_t distance)
+            {
+                buckets_[distance % kBucketCount].push_back(state);
+                ++size_;
+            }
+
+            [[nodiscard]] bool empty() const { return size_ == 0; }
+
+            /**
+             * @brief Moves to the lowest non-empty bucket and returns its distance
+             */
+            std::uint32_t advance()
+            {
+                while (buckets_[current_ % kBucketCount].empty())
+                {
+                    ++current_;
+                }
+                return current_;
+            }
+
+            /**
+             * @brief Takes one state from the bucket selected by advance()
+             */
+            std::uint32_t pop()
+            {
+                auto& bucket = buckets_[current_ % kBucketCount];
+                const std::uint32_t state = bucket.back();
+                bucket.pop_back();
+                --size_;
+                return state;
+            }
+
+        private:
+            static constexpr std::uint32_t kBucketCount = kTurnCost + 1;
+
+            std::array<std::vector<std::uint32_t>, kBucketCount> buckets_;
+            std::uint32_t current_ = 0;
+            std::size_t size_ = 0;
+        };
+
+        /**
+         * @brief Dial's algorithm over (cell, heading) states
+         *
+         * With Reverse set, moves are followed backwards (a step goes against
+         * the heading), which yields distances *to* the seeds in the forward
+         * graph. Turning is its own reverse.
+         */
+        template <bool Reverse>
+        std::vector<std::uint32_t> run_search(const Maze& maze, const std::vector<std::uint32_t>& seeds)
+        {
+            std::vector<std::uint32_t> dist(maze.open.size() * kHeadingCount, kUnreachable);
+            const std::array<int, kHeadingCount> steps = {
+                maze.step(Heading::East), maze.step(Heading::South),
+                maze.step(Heading::West), maze.step(Heading::North)};
+
+            BucketQueue queue;
+            for (const std::uint32_t seed : seeds)
+            {
+                dist[seed] = 0;
+                queue.push(seed, 0);
+            }
+
+            const auto relax = [&](std::uint32_t state, std::uint32_t distance) {
+                if (distance < dist[state])
+                {
+                    dist[state] = distance;
+                    queue.push(state, distance);
+                }
+            };
+
+            while (!queue.empty())
+            {
+                const std::uint32_t distance = queue.advance();
+                const std::uint32_t state = queue.pop();
+                if (dist[state] != distance)
+                {
+                    continue; // Stale entry, already settled cheaper
+                }
+
+                const int cell = static_cast<int>(state / kHeadingCount);
+                const std::uint32_t heading = state % kHeadingCount;
+                const int next = Reverse ? cell - steps[heading] : cell + steps[heading];
+                if (maze.open[next])
+                {
+                    relax(static_cast<std::uint32_t>(next) * kHeadingCount + heading, distance + kStepCost);
+                }
+
+                const std::uint32_t base = state - heading;
+                relax(base + (heading + 1) % kHeadingCount, distance + kTurnCost);
+                relax(base + (heading + kHeadingCount - 1) % kHeadingCount, distance + kTurnCost);
+            }
+            return dist;
+        }
+
+        /**
+         * @brief Lowest score over all headings at E
+         * @throws std::runtime_error if E was not reached
+         */
+        std::uint32_t best_score(const Maze& maze, const std::vector<std::uint32_t>& from_start)
+        {
+            std::uint32_t best = kUnreachable;
+            for (int h = 0; h < kHeadingCount; ++h)
+            {
+                best = std::min(best, from_start[state_index(maze.end, static_cast<Heading>(h))]);
+            }
+            if (best == kUnreachable)
+            {
+                throw std::runtime_error("End tile is unreachable from the start");
+            }
+            return best;
+        }
+    } // namespace
+
+    std::vector<std::uint32_t> distances_from_start(const Maze& maze)
+    {
+        return run_search<false>(maze, {static_cast<std::uint32_t>(state_index(maze.start, Heading::East))});
+    }
+
+    std::vector<std::uint32_t> distances_to_end(const Maze& maze)
+    {
+        std::vector<std::uint32_t> seeds;
+        for (int h = 0; h < kHeadingCount; ++h)
+        {
+            seeds.push_back(static_cast<std::uint32_t>(state_index(maze.end, static_cast<Heading>(h))));
+        }
+        return run_search<true>(maze, seeds);
+    }
+
+    // ========================================================================
+    // SOLUTION
+    // ========================================================================
+
+    MazeSolution solve_maze(const Maze& maze)
+    {
+        const auto from_start = distances_from_start(maze);
+        const auto to_end = distances_to_end(maze);
+
+        const std::uint32_t best = best_score(maze, from_start);
+
+        std::size_t tiles = 0;
+        for (std::size_t cell = 0; cell < maze.open.size(); ++cell)
+        {
+            if (!maze.open[cell])
+            {
+                continue;
+            }
+            for (std::size_t h = 0; h < kHeadingCount; ++h)
+            {
+                const std::size_t state = cell * kHeadingCount + h;
+                if (from_start[state] != kUnreachable && to_end[state] != kUnreachable &&
+                    std::uint64_t{from_start[state]} + to_end[state] == best)
+                {
+                    ++tiles;
+                    break;
+                }
+            }
+        }
+        return {best, tiles};
+    }
+
+    // ========================================================================
+    // CONTRACTED GRAPH SEARCH
+    // ========================================================================
+
+    namespace
+    {
+        std::uint32_t edge_weight(const utils::MazeEdge& edge)
+        {
+            return static_cast<std::uint32_t>(edge.steps) * kStepCost +
+                   static_cast<std::uint32_t>(edge.turns) * kTurnCost;
+        }
+
+        /**
+         * @brief Dijkstra over (node, heading) states of a contracted maze
+         *
+         * Forward, a state leaves along its heading's out-edge; with Reverse
+         * set it goes back along the edge that arrives with its heading.
+         */
+        template <bool Reverse>
+        std::vector<std::uint32_t> run_graph_search(const utils::MazeGraph& graph,
+                                                    const std::vector<std::uint32_t>& seeds)
+        {
+            using Entry = std::pair<std::uint32_t, std::uint32_t>; // (distance, state)
+            std::vector<std::uint32_t> dist(graph.nodes.size() * kHeadingCount, kUnreachable);
+            std::priority_queue<Entry, std::vector<Entry>, std::greater<>> queue;
+            for (const std::uint32_t seed : seeds)
+            {
+                dist[seed] = 0;
+                queue.emplace(0, seed);
+            }
+
+            const auto relax = [&](std::uint32_t state, std::uint32_t distance) {
+                if (distance < dist[state])
+                {
+                    dist[state] = distance;
+                    queue.emplace(distance, state);
+                }
+            };
+
+            while (!queue.empty())
+            {
+                const auto [distance, state] = queue.top();
+                queue.pop();
+                if (dist[state] != distance)
+                {
+                    continue;
+                }
+
+                const auto& node = graph.nodes[state / kHeadingCount];
+                const std::uint32_t heading = state % kHeadingCount;
+                const int edge_id = Reverse ? node.in_edge[heading] : node.out_edge[heading];
+                if (edge_id >= 0)
+                {
+                    const auto& edge = graph.edges[edge_id];
+                    const int other = Reverse ? edge.from : edge.to;
+                    const int other_heading = Reverse ? edge.exit_heading : edge.entry_heading;
+                    relax(static_cast<std::uint32_t>(other * kHeadingCount + other_heading),
+                          distance + edge_weight(edge));
+                }
+
+                const std::uint32_t base = state - heading;
+                relax(base + (heading + 1) % kHeadingCount, distance + kTurnCost);
+                relax(base + (heading + kHeadingCount - 1) % kHeadingCount, distance + kTurnCost);
+            }
+            return dist;
+        }
+    } // namespace
+
+    MazeSolution solve_maze_contracted(const Maze& maze)
+    {
+        const std::array<int, 2> keep = {maze.start, maze.end};
+        const auto graph = utils::contract_maze(maze.open, maze.stride, keep);
+        const int start_node = graph.node_of_cell[maze.start];
+        const int end_node = graph.node_of_cell[maze.end];
+
+        const auto node_state = [](int node, int heading) {
+            return static_cast<std::uint32_t>(node * kHeadingCount + heading);
+        };
+
+        const auto from_start = run_graph_search<false>(graph, {node_state(start_node, 0)});
+        std::vector<std::uint32_t> end_seeds;
+        std::uint32_t best = kUnreachable;
+        for (int h = 0; h < kHeadingCount; ++h)
+        {
+            end_seeds.push_back(node_state(end_node, h));
+            best = std::min(best, from_start[node_state(end_node, h)]);
+        }
+        if (best == kUnreachable)
+        {
+            throw std::runtime_error("End tile is unreachable from the start");
+        }
+        const auto to_end = run_graph_search<true>(graph, end_seeds);
+
+        const auto on_best_path = [&](std::uint32_t forward_state, std::uint32_t weight, std::uint32_t backward_state) {
+            return from_start[forward_state] != kUnreachable && to_end[backward_state] != kUnreachable &&
+                   std::uint64_t{from_start[forward_state]} + weight + to_end[backward_state] == best;
+        };
+
+        std::vector<char> marked(maze.open.size(), 0);
+        for (std::size_t id = 0; id < graph.nodes.size(); ++id)
+        {
+            for (int h = 0; h < kHeadingCount; ++h)
+            {
+                const std::uint32_t state = node_state(static_cast<int>(id), h);
+                if (on_best_path(state, 0, state))
+                {
+                    marked[graph.nodes[id].cell] = 1;
+                }
+            }
+        }
+        for (const auto& edge : graph.edges)
+        {
+            if (on_best_path(node_state(edge.from, edge.exit_heading), edge_weight(edge),
+                             node_state(edge.to, edge.entry_heading)))
+            {
+                for (const int tile : graph.edge_tiles(edge))
+                {
+                    marked[tile] = 1;
+                }
+            }
+        }
+        return {best, static_cast<std::size_t>(std::count(marked.begin(), marked.end(), 1))};
+    }
+
+    // ========================================================================
+    // BIDIRECTIONAL SEARCH
+    // ========================================================================
+
+    namespace
+    {
+        using SharedDistances = std::vector<std::atomic<std::uint32_t>>;
+
+        /// mu before the two searches have met
+        constexpr std::uint64_t kNoMeeting = std::numeric_limits<std::uint64_t>::max();
+
+        /**
+         * @brief State both search threads publish to each other
+         */
+        struct Rendezvous
+        {
+            std::atomic<std::uint64_t> best{kNoMeeting};                 ///< mu, cheapest S-to-E cost seen
+            std::array<std::atomic<std::uint32_t>, 2> frontier{};       ///< Current bucket of each side
+        };
+
+        void offer_meeting(Rendezvous& meeting, std::uint64_t cost)
+        {
+            std::uint64_t current = meeting.best.load(std::memory_order_relaxed);
+            while (cost < current && !meeting.best.compare_exchange_weak(current, cost))
+            {
+            }
+        }
+
+        /**
+         * @brief One side of the bidirectional search (side 0 forward, 1 backward)
+         */
+        template <bool Reverse>
+        void search_side(const Maze& maze, const std::vector<std::uint32_t>& seeds, SharedDistances& own,
+                         const SharedDistances& other, Rendezvous& meeting)
+        {
+            constexpr int side = Reverse ? 1 : 0;
+            const std::array<int, kHeadingCount> steps = {
+                maze.step(Heading::East), maze.step(Heading::South),
+                maze.step(Heading::West), maze.step(Heading::North)};
+
+            BucketQueue queue;
+            const auto relax = [&](std::uint32_t state, std::uint32_t distance) {
+                if (distance < own[state].load(std::memory_order_relaxed))
+                {
+                    own[state].store(distance); // seq_cst: ordered before the read below
+                    queue.push(state, distance);
+                    if (const std::uint32_t there = other[state].load(); there != kUnreachable)
+                    {
+                        offer_meeting(meeting, std::uint64_t{distance} + there);
+                    }
+                }
+            };
+            for (const std::uint32_t seed : seeds)
+            {
+                relax(seed, 0);
+            }
+
+            while (!queue.empty())
+            {
+                const std::uint32_t distance = queue.advance();
+                meeting.frontier[side].store(distance, std::memory_order_relaxed);
+                if (std::uint64_t{distance} + meeting.frontier[1 - side].load(std::memory_order_relaxed) >
+                    meeting.best.load(std::memory_order_relaxed))
+                {
+                    return;
+                }
+
+                const std::uint32_t state = queue.pop();
+                if (own[state].load(std::memory_order_relaxed) != distance)
+                {
+                    continue;
+                }
+
+                const int cell = static_cast<int>(state / kHeadingCount);
+                const std::uint32_t heading = state % kHeadingCount;
+                const int next = Reverse ? cell - steps[heading] : cell + steps[heading];
+                if (maze.open[next])
+                {
+                    relax(static_cast<std::uint32_t>(next) * kHeadingCount + heading, distance + kStepCost);
+                }
+
+                const std::uint32_t base = state - heading;
+                relax(base + (heading + 1) % kHeadingCount, distance + kTurnCost);
+                relax(base + (heading + kHeadingCount - 1) % kHeadingCount, distance + kTurnCost);
+            }
+            meeting.frontier[side].store(kUnreachable, std::memory_order_relaxed);
+        }
+    } // namespace
+
+    MazeSolution solve_maze_bidirectional(const Maze& maze)
+    {
+        const std::size_t state_count = maze.open.size() * kHeadingCount;
+        SharedDistances from_start(state_count);
+        SharedDistances to_end(state_count);
+        for (std::size_t state = 0; state < state_count; ++state)
+        {
+            from_start[state].store(kUnreachable, std::memory_order_relaxed);
+            to_end[state].store(kUnreachable, std::memory_order_relaxed);
+        }
+
+        std::vector<std::uint32_t> end_seeds;
+        for (int h = 0; h < kHeadingCount; ++h)
+        {
+            end_seeds.push_back(static_cast<std::uint32_t>(state_index(maze.end, static_cast<Heading>(h))));
+        }
+        const std::vector<std::uint32_t> start_seeds = {
+            static_cast<std::uint32_t>(state_index(maze.start, Heading::East))};
+
+        Rendezvous meeting;
+        {
+            std::jthread forward([&] { search_side<false>(maze, start_seeds, from_start, to_end, meeting); });
+            std::jthread backward([&] { search_side<true>(maze, end_seeds, to_end, from_start, meeting); });
+        }
+
+        const std::uint64_t best = meeting.best.load();
+        if (best == kNoMeeting)
+        {
+            throw std::runtime_error("End tile is unreachable from the start");
+        }
+
+        // Every best path crosses from forward-settled to backward-settled
+        // states at a state whose two entries are exact and sum to best.
+        // From there, tight edges lead through exact entries back to S (in
+        // from_start) and on to E (in to_end).
+        const std::array<int, kHeadingCount> steps = {
+            maze.step(Heading::East), maze.step(Heading::South),
+            maze.step(Heading::West), maze.step(Heading::North)};
+        const auto dist = [](const SharedDistances& table, std::uint32_t state) {
+            return table[state].load(std::memory_order_relaxed);
+        };
+
+        std::vector<std::uint8_t> traced(state_count, 0); // bit 0: towards S, bit 1: towards E
+        std::vector<std::pair<std::uint32_t, std::uint8_t>> stack;
+        for (std::uint32_t state = 0; state < state_count; ++state)
+        {
+            const std::uint32_t forward = dist(from_start, state);
+            const std::uint32_t backward = dist(to_end, state);
+            if (forward != kUnreachable && backward != kUnreachable && std::uint64_t{forward} + backward == best)
+            {
+                stack.emplace_back(state, 1);
+                stack.emplace_back(state, 2);
+            }
+        }
+
+        std::vector<char> marked(maze.open.size(), 0);
+        while (!stack.empty())
+        {
+            const auto [state, direction] = stack.back();
+            stack.pop_back();
+            if (traced[state] & direction)
+            {
+                continue;
+            }
+            traced[state] |= direction;
+
+            const int cell = static_cast<int>(state / kHeadingCount);
+            const std::uint32_t heading = state % kHeadingCount;
+            marked[cell] = 1;
+
+            const bool towards_start = direction == 1;
+            const SharedDistances& table = towards_start ? from_start : to_end;
+            const std::uint32_t here = dist(table, state);
+            const auto follow = [&](std::uint32_t neighbour, std::uint32_t weight) {
+                const std::uint32_t there = dist(table, neighbour);
+                if (there != kUnreachable && there + weight == here)
+                {
+                    stack.emplace_back(neighbour, direction);
+                }
+            };
+
+            const int next = towards_start ? cell - steps[heading] : cell + steps[heading];
+            if (maze.open[next])
+            {
+                follow(static_cast<std::uint32_t>(next) * kHeadingCount + heading, kStepCost);
+            }
+            const std::uint32_t base = state - heading;
+            follow(base + (heading + 1) % kHeadingCount, kTurnCost);
+            follow(base + (heading + kHeadingCount - 1) % kHeadingCount, kTurnCost);
+        }
+
+        return {static_cast<std::uint32_t>(best), static_cast<std::size_t>(std::count(marked.begin(), marked.end(), 1))};
+    }
 
-std::string solve_part1(const std::vector<std::string>& input) {
-    // TODO: Implement solution for part 1
-    return "Not implemented";
-}
+    std::string solve_part1(const std::vector<std::string>& input)
+    {
+        const Maze maze = parse_maze(input);
+        const auto from_start = distances_from_start(maze);
 
-std::string solve_part2(const std::vector<std::string>& input) {
-    // TODO: Implement solution for part 2
-    return "Not implemented";
-}
+        return std::to_string(best_score(maze, from_start));
+    }
 
-} // namespace aoc::day16
\ No newline at end of file
+    std::string solve_part2(const std::vector<std::string>& input)
+    {
+        return std::to_string(solve_maze_contracted(parse_maze(input)).best_path_tiles);
+    }
+} // namespace aoc::day16
@@ -1,12 +1,26 @@
 /**
  * @file day17.cpp
  * @brief Implementation of Day 17: Chronospatial Computer
+ *
+ * PART 2: The loop consumes k bits of A per output, so output i only sees
+ * A >> (k * i). Working from the last output back, a candidate prefix of A
+ * gains k low bits per level and survives if running it reproduces the
+ * output suffix placed so far. Computer itself is the oracle, so any mix of
+ * bst/bxl/bxc/cdv that rebuilds B and C from A each pass is supported.
+ *
+ * PARALLELISM: Each level's (candidate, low bits) pairs are independent
+ * runs, claimed by std::jthread workers through an atomic index. The
+ * survivors are sorted, so the first full-length candidate is the minimum.
  */
 
 #include "days/day17.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <ranges>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 #include <sstream>
 
@@ -176,6 +190,135 @@ namespace aoc::day17
         return result;
     }
 
+    // ============================================================================
+    // REVERSE SEARCH IMPLEMENTATION
+    // ============================================================================
+
+    namespace
+    {
+        /**
+         * @brief Bits of A consumed per loop pass, after checking the Part 2 shape.
+         */
+        int shiftPerPass(const Program& program)
+        {
+            const auto& code = program.instructions;
+            if (code.size() < 2 || code.size() % 2 != 0 || code[code.size() - 2] != 3 || code.back() != 0)
+            {
+                throw std::invalid_argument("Program must be a single loop ending in 'jnz 0'");
+            }
+
+            int shift = 0;
+            int shifts = 0;
+            int outputs = 0;
+            for (size_t ip = 0; ip + 2 < code.size(); ip += 2)
+            {
+                if (code[ip] == 3)
+                {
+                    throw std::invalid_argument("Program may only jump at its end");
+                }
+                if (code[ip] == 0)
+                {
+                    shift = code[ip + 1];
+                    ++shifts;
+                }
+                if (code[ip] == 5)
+                {
+                    ++outputs;
+                }
+            }
+            if (shifts != 1 || shift < 1 || shift > 3)
+            {
+                throw std::invalid_argument("Program must shift A by a literal 1-3 bits once per pass");
+            }
+            if (outputs != 1)
+            {
+                throw std::invalid_argument("Program must output exactly one value per pass");
+            }
+            return shift;
+        }
+
+        /**
+         * @brief Whether running with register A = a prints exactly the last `length` target values.
+         *
+         * Stops as soon as the output diverges, so most rejected candidates cost
+         * only a few instructions.
+         */
+        bool printsSuffix(const Program& program, int64_t a, int64_t B, int64_t C, const std::vector<int>& target,
+                          size_t length)
+        {
+            const size_t offset = target.size() - length;
+            Computer computer{program, a, B, C};
+            while (!computer.isHalted())
+            {
+                const size_t printed = computer.getOutput().size();
+                computer.executeInstruction();
+                const auto& output = computer.getOutput();
+                if (output.size() != printed &&
+                    (printed == length || output.back() != target[offset + printed]))
+                {
+                    return false;
+                }
+            }
+            return computer.getOutput().size() == length;
+        }
+    } // namespace
+
+    std::optional<int64_t> findRegisterA(const Program& program, const std::vector<int>& target, int64_t B, int64_t C,
+                                         unsigned thread_count)
+    {
+        const int shift = shiftPerPass(program);
+        if (target.empty())
+        {
+            return std::nullopt; // Every run prints at least once
+        }
+        if (target.size() * static_cast<size_t>(shift) > 63)
+        {
+            throw std::invalid_argument("Register A for this target would not fit in 63 bits");
+        }
+
+        if (thread_count == 0) thread_count = std::max(1u, std::thread::hardware_concurrency());
+        const int64_t fanout = int64_t{1} << shift;
+
+        std::vector<int64_t> candidates = {0};
+        for (size_t length = 1; length <= target.size() && !candidates.empty(); ++length)
+        {
+            const size_t work = candidates.size() * static_cast<size_t>(fanout);
+            std::vector<std::vector<int64_t>> found(std::min<size_t>(thread_count, work));
+            std::atomic<size_t> next_item{0};
+            {
+                std::vector<std::jthread> workers;
+                workers.reserve(found.size());
+                for (auto& survivors : found)
+                {
+                    workers.emplace_back([&, &survivors = survivors] {
+                        for (size_t item = next_item++; item < work; item = next_item++)
+                        {
+                            const int64_t a = (candidates[item / static_cast<size_t>(fanout)] << shift) |
+                                              static_cast<int64_t>(item % static_cast<size_t>(fanout));
+                            if (printsSuffix(program, a, B, C, target, length))
+                            {
+                                survivors.push_back(a);
+                            }
+                        }
+                    });
+                }
+            }
+
+            candidates.clear();
+            for (const auto& survivors : found)
+            {
+                candidates.insert(candidates.end(), survivors.begin(), survivors.end());
+            }
+            std::ranges::sort(candidates);
+        }
+
+        if (candidates.empty())
+        {
+            return std::nullopt;
+        }
+        return candidates.front();
+    }
+
     std::string solve_part1(const std::vector<std::string>& input)
     {
         return runProgram(input);
@@ -183,19 +326,13 @@ namespace aoc::day17
 
     std::string solve_part2(const std::vector<std::string>& input)
     {
-        // TODO: Implement part 2 solution
-        //
-        // EXPECTED REQUIREMENT:
-        // Find the value for register A that causes the program to output
-        // a specific sequence (often the program itself).
-        //
-        // APPROACH HINTS:
-        // - The program likely processes A in chunks of 3 bits at a time
-        // - Each iteration outputs one 3-bit value and shifts A right
-        // - Work backwards from the desired output to find valid A values
-        // - May need to try candidates and verify
-        // - Consider the relationship between A, B, C during execution
-
-        return "Not implemented";
+        const auto parsed = parseInput(input);
+        const Program program{parsed.program};
+        const auto a = findRegisterA(program, parsed.program, parsed.B, parsed.C);
+        if (!a)
+        {
+            throw std::runtime_error("No value of register A makes the program output itself");
+        }
+        return std::to_string(*a);
     }
 } // namespace aoc::day17
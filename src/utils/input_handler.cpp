@@ -9,6 +9,11 @@
 #include <sstream>
 #include <stdexcept>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 namespace aoc::utils {
 
 std::vector<std::string> read_input(const std::string& filepath) {
@@ -41,4 +46,84 @@ std::string read_input_raw(const std::string& filepath) {
     return buffer.str();
 }
 
+MappedFile::MappedFile(const std::string& filepath) {
+    const int fd = ::open(filepath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open file: " + filepath);
+    }
+
+    struct stat info{};
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Could not stat file: " + filepath);
+    }
+
+    size_ = static_cast<std::size_t>(info.st_size);
+    if (size_ > 0) {
+        data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd);
+
+    if (data_ == MAP_FAILED) {
+        data_ = nullptr;
+        throw std::runtime_error("Could not map file: " + filepath);
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (data_ != nullptr) {
+        ::munmap(data_, size_);
+    }
+}
+
+std::string_view MappedFile::view() const {
+    return {static_cast<const char*>(data_), data_ != nullptr ? size_ : 0};
+}
+
+ChunkedFileReader::ChunkedFileReader(const std::string& filepath, const std::size_t chunk_size)
+    : file_(filepath, std::ios::binary), buffer_(chunk_size == 0 ? 1 : chunk_size, '\0') {
+    if (!file_.is_open()) {
+        throw std::runtime_error("Could not open file: " + filepath);
+    }
+}
+
+bool ChunkedFileReader::refill() {
+    file_.read(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    begin_ = 0;
+    end_ = static_cast<std::size_t>(file_.gcount());
+    return end_ > 0;
+}
+
+bool ChunkedFileReader::read_line(std::string& line) {
+    line.clear();
+    bool any = false;
+    while (true) {
+        if (begin_ == end_ && !refill()) {
+            return any;
+        }
+        any = true;
+        const std::string_view pending(buffer_.data() + begin_, end_ - begin_);
+        const auto newline = pending.find('\n');
+        if (newline != std::string_view::npos) {
+            line.append(pending.substr(0, newline));
+            begin_ += newline + 1;
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            return true;
+        }
+        line.append(pending);
+        begin_ = end_;
+    }
+}
+
+std::string_view ChunkedFileReader::next_chunk() {
+    if (begin_ == end_ && !refill()) {
+        return {};
+    }
+    const std::string_view chunk(buffer_.data() + begin_, end_ - begin_);
+    begin_ = end_;
+    return chunk;
+}
+
 } // namespace aoc::utils
\ No newline at end of file
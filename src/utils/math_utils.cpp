@@ -5,8 +5,29 @@
 
 #include "utils/math_utils.hpp"
 
+#include <algorithm>
+
 namespace aoc::utils {
 
+std::string to_string(int128 value) {
+    if (value == 0) {
+        return "0";
+    }
+
+    const bool negative = value < 0;
+    std::string digits;
+    while (value != 0) {
+        const int digit = static_cast<int>(value % 10);
+        digits.push_back(static_cast<char>('0' + (negative ? -digit : digit)));
+        value /= 10;
+    }
+    if (negative) {
+        digits.push_back('-');
+    }
+    std::reverse(digits.begin(), digits.end());
+    return digits;
+}
+
 long long gcd(long long a, long long b) {
     while (b != 0) {
         const long long temp = b;
@@ -0,0 +1,116 @@
+/**
+ * @file maze_graph.cpp
+ * @brief Implementation of maze corridor contraction
+ */
+
+#include "utils/maze_graph.hpp"
+
+#include <stdexcept>
+
+namespace aoc::utils {
+
+namespace {
+
+constexpr int kHeadings = 4;
+constexpr std::array<int, kHeadings> kDx = {1, 0, -1, 0};
+constexpr std::array<int, kHeadings> kDy = {0, 1, 0, -1};
+
+/**
+ * @brief Grid geometry shared by the contraction steps
+ */
+struct Grid {
+    std::span<const char> open;
+    int width;
+    int height;
+
+    /// Flat neighbour of `cell` in `heading`, or -1 when it is off the grid or a wall
+    [[nodiscard]] int neighbour(const int cell, const int heading) const {
+        const int x = cell % width + kDx[heading];
+        const int y = cell / width + kDy[heading];
+        if (x < 0 || x >= width || y < 0 || y >= height) {
+            return -1;
+        }
+        const int next = y * width + x;
+        return open[next] ? next : -1;
+    }
+};
+
+} // namespace
+
+MazeGraph contract_maze(const std::span<const char> open, const int width, const std::span<const int> keep) {
+    if (width <= 0 || open.size() % static_cast<std::size_t>(width) != 0) {
+        throw std::invalid_argument("Maze mask must hold a whole number of rows");
+    }
+    const Grid grid{open, width, static_cast<int>(open.size() / static_cast<std::size_t>(width))};
+
+    MazeGraph graph;
+    graph.node_of_cell.assign(open.size(), -1);
+
+    const auto add_node = [&](const int cell) {
+        if (graph.node_of_cell[cell] < 0) {
+            graph.node_of_cell[cell] = static_cast<int>(graph.nodes.size());
+            MazeNode node{cell, {}, {}};
+            node.out_edge.fill(-1);
+            node.in_edge.fill(-1);
+            graph.nodes.push_back(node);
+        }
+    };
+
+    for (const int cell : keep) {
+        if (cell < 0 || static_cast<std::size_t>(cell) >= open.size() || !open[cell]) {
+            throw std::invalid_argument("Kept maze cell must be a walkable cell");
+        }
+        add_node(cell);
+    }
+    for (int cell = 0; cell < static_cast<int>(open.size()); ++cell) {
+        if (!open[cell]) {
+            continue;
+        }
+        int degree = 0;
+        for (int h = 0; h < kHeadings; ++h) {
+            degree += grid.neighbour(cell, h) >= 0 ? 1 : 0;
+        }
+        if (degree != 2) {
+            add_node(cell);
+        }
+    }
+
+    // Walk each corridor from both of its ends; a corridor cell has exactly
+    // one way forward that is not back where it came from.
+    for (int id = 0; id < static_cast<int>(graph.nodes.size()); ++id) {
+        for (int exit_heading = 0; exit_heading < kHeadings; ++exit_heading) {
+            int cell = grid.neighbour(graph.nodes[id].cell, exit_heading);
+            if (cell < 0) {
+                continue;
+            }
+
+            MazeEdge edge{id, -1, exit_heading, exit_heading, 1, 0, graph.tiles.size(), 0};
+            int heading = exit_heading;
+            while (graph.node_of_cell[cell] < 0) {
+                graph.tiles.push_back(cell);
+                const int left = (heading + kHeadings - 1) % kHeadings;
+                const int right = (heading + 1) % kHeadings;
+                for (const int next_heading : {heading, left, right}) {
+                    if (const int next = grid.neighbour(cell, next_heading); next >= 0) {
+                        edge.turns += next_heading != heading ? 1 : 0;
+                        heading = next_heading;
+                        cell = next;
+                        break;
+                    }
+                }
+                ++edge.steps;
+            }
+            edge.to = graph.node_of_cell[cell];
+            edge.entry_heading = heading;
+            edge.tile_end = graph.tiles.size();
+
+            const int edge_id = static_cast<int>(graph.edges.size());
+            graph.nodes[id].out_edge[exit_heading] = edge_id;
+            graph.nodes[edge.to].in_edge[heading] = edge_id;
+            graph.edges.push_back(edge);
+        }
+    }
+    return graph;
+}
+
+} // namespace aoc::utils
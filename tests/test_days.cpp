@@ -35,6 +35,10 @@
 #include "days/day25.hpp"
 #include "utils/input_handler.hpp"
 
+#include <cstdio>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -155,6 +159,34 @@ TEST(DayTests, Day07) {
     EXPECT_EQ(part2_result, "Not implemented");
 }
 
+TEST(DayTests, Day07MeetInTheMiddle) {
+    const auto input = aoc::utils::read_input(get_input_path("day07.txt"));
+    const auto equations = aoc::day07::parse_input(input);
+
+    // The meet-in-the-middle solver must agree with the recursive one on the puzzle input
+    std::int64_t part1_sum = 0;
+    std::int64_t part2_sum = 0;
+    for (const auto& equation : equations) {
+        if (aoc::day07::is_valid_equation_meet_in_the_middle(equation, false)) part1_sum += equation.test_value;
+        if (aoc::day07::is_valid_equation_meet_in_the_middle(equation, true)) part2_sum += equation.test_value;
+    }
+    EXPECT_EQ(std::to_string(part1_sum), aoc::day07::solve_part1(input));
+    EXPECT_EQ(std::to_string(part2_sum), aoc::day07::solve_part2(input));
+
+    // 24 operands: 1 + 2 * 1 || 2 + ... evaluated left to right
+    aoc::day07::Equation long_equation{0, {}};
+    for (int i = 0; i < 24; ++i) long_equation.operands.push_back(i % 3 + 1);
+    std::int64_t value = long_equation.operands[0];
+    for (std::size_t i = 1; i < long_equation.operands.size(); ++i) {
+        const auto operand = long_equation.operands[i];
+        value = (i % 3 == 0) ? value * 10 + operand : (i % 3 == 1 ? value + operand : value * operand);
+    }
+    long_equation.test_value = value;
+    EXPECT_TRUE(aoc::day07::is_valid_equation_meet_in_the_middle(long_equation, true));
+    long_equation.test_value = value * 7 + 1000000007;
+    EXPECT_FALSE(aoc::day07::is_valid_equation_meet_in_the_middle(long_equation, false));
+}
+
 // ============================================================================
 // Day 8 Tests
 // ============================================================================
@@ -170,6 +202,42 @@ TEST(DayTests, Day08) {
     EXPECT_EQ(part2_result, "Not implemented");
 }
 
+TEST(DayTests, Day08NonSquareGrid) {
+    // 10 columns, 3 rows: antinodes at x = 1 and x = 7 must stay in bounds
+    const std::vector<std::string> input = {
+        "..........",
+        "...a.a....",
+        "..........",
+    };
+
+    EXPECT_EQ(aoc::day08::solve_part1(input), "2");
+    // The pair is 2 apart, so the reduced step of 1 covers the whole row
+    EXPECT_EQ(aoc::day08::solve_part2(input), "10");
+    const auto sparse = aoc::day08::parse_sparse_map({"10 3", "a 3 1", "a 5 1"});
+    EXPECT_EQ(std::to_string(aoc::day08::count_antinodes_sparse(sparse, true, 2)), aoc::day08::solve_part2(input));
+}
+
+TEST(DayTests, Day08SparseMode) {
+    const auto grid = aoc::utils::read_input(get_input_path("day08.txt"));
+
+    // Re-encode the puzzle grid as a coordinate list and compare against the dense engine
+    std::vector<std::string> list = {std::to_string(grid[0].size()) + " " + std::to_string(grid.size())};
+    for (size_t y = 0; y < grid.size(); ++y) {
+        for (size_t x = 0; x < grid[y].size(); ++x) {
+            if (grid[y][x] != '.') list.push_back(std::string(1, grid[y][x]) + " " + std::to_string(x) + " " + std::to_string(y));
+        }
+    }
+    const auto map = aoc::day08::parse_sparse_map(list);
+
+    EXPECT_EQ(std::to_string(aoc::day08::count_antinodes_sparse(map, false, 4)), aoc::day08::solve_part1(grid));
+    EXPECT_EQ(std::to_string(aoc::day08::count_antinodes_sparse(map, true, 4)), aoc::day08::solve_part2(grid));
+
+    // gcd-reduced steps: (0,0) and (2,4) are collinear with (1,2)
+    const auto diagonal = aoc::day08::parse_sparse_map({"1000000 1000000", "a 0 0", "a 2 4"});
+    EXPECT_EQ(aoc::day08::count_antinodes_sparse(diagonal, false, 2), 1u);
+    EXPECT_EQ(aoc::day08::count_antinodes_sparse(diagonal, true, 2), 500000u);
+}
+
 // ============================================================================
 // Day 9 Tests
 // ============================================================================
@@ -185,6 +253,77 @@ TEST(DayTests, Day09) {
     EXPECT_EQ(part2_result, "Not implemented");
 }
 
+TEST(DayTests, Day09SpanCompaction) {
+    EXPECT_EQ(aoc::day09::solve_part1({"2333133121414131402"}), "1928");
+    EXPECT_EQ(aoc::day09::solve_part1({"12345"}), "60");
+
+    // Must match the block-by-block reference on the puzzle input
+    const auto input = aoc::utils::read_input(get_input_path("day09.txt"));
+    auto disk = aoc::day09::parse_disk_map(input[0]);
+    for (int left = 0, right = static_cast<int>(disk.size()) - 1;; ) {
+        left = aoc::day09::find_first_free_space(disk, left);
+        right = aoc::day09::find_last_file_block(disk, right);
+        if (left == -1 || right == -1 || left >= right) break;
+        std::swap(disk[left], disk[right]);
+    }
+    EXPECT_EQ(aoc::day09::solve_part1(input), std::to_string(aoc::day09::calculate_checksum(disk)));
+}
+
+TEST(DayTests, Day09Streaming) {
+    const std::string path = get_input_path("day09.txt");
+    const auto input = aoc::utils::read_input(path);
+
+    EXPECT_EQ(aoc::utils::to_string(aoc::day09::stream_part1_checksum(path)), aoc::day09::solve_part1(input));
+    EXPECT_EQ(aoc::utils::to_string(aoc::day09::stream_part2_checksum(path)), aoc::day09::solve_part2(input));
+    EXPECT_EQ(aoc::utils::to_string(aoc::day09::compact_files_checksum("2333133121414131402\n")), "2858");
+}
+
+TEST(DayTests, Day09BoundedFileCompaction) {
+    // Maps with a single file length: spans passed by that length's cursor
+    // must be forgotten even when no length-1 file exists
+    for (const std::string unit : {"19", "29", "39", "93"}) {
+        std::string single_length;
+        for (int i = 0; i < 20000; ++i) single_length += unit;
+        std::size_t peak = 0;
+        const auto checksum = aoc::day09::compact_files_checksum(single_length, &peak);
+        EXPECT_EQ(aoc::utils::to_string(checksum), aoc::day09::solve_part2({single_length})) << unit;
+        EXPECT_LE(peak, 2u) << unit;
+    }
+
+    // Random maps agree with the span-index solver
+    unsigned long long seed = 99;
+    for (int map = 0; map < 30; ++map) {
+        std::string disk_map;
+        for (int digit = 0; digit < 1001; ++digit) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            disk_map += static_cast<char>('0' + (seed >> 33) % 10);
+        }
+        EXPECT_EQ(aoc::utils::to_string(aoc::day09::compact_files_checksum(disk_map)),
+                  aoc::day09::solve_part2({disk_map}));
+    }
+}
+
+TEST(DayTests, Day09FreeSpanIndex) {
+    EXPECT_EQ(aoc::day09::solve_part2({"2333133121414131402"}), "2858");
+
+    // Best fit is the leftmost span of any sufficient length, not the smallest one
+    aoc::day09::FreeSpanIndex index({{2, 5, -1}, {10, 3, -1}, {20, 9, -1}});
+    EXPECT_EQ(index.allocate(3, 30), 2);
+    EXPECT_EQ(index.allocate(2, 30), 5);
+    EXPECT_EQ(index.allocate(3, 30), 10);
+    EXPECT_EQ(index.allocate(9, 15), std::nullopt);
+    EXPECT_EQ(index.allocate(9, 30), 20);
+    EXPECT_EQ(index.allocate(4, 15), std::nullopt);
+
+    // Lengths beyond one disk map digit are rejected instead of indexing past the heaps
+    EXPECT_THROW((void)aoc::day09::FreeSpanIndex({{0, 10, -1}}), std::invalid_argument);
+    EXPECT_THROW(index.add({40, aoc::day09::FreeSpanIndex::kMaxSpanLength + 1, -1}), std::invalid_argument);
+    EXPECT_THROW((void)index.allocate(10, 30), std::invalid_argument);
+    EXPECT_THROW((void)index.allocate(-1, 30), std::invalid_argument);
+
+    EXPECT_EQ(aoc::day09::span_checksum({4, 3, 7}), 7 * (4 + 5 + 6));
+}
+
 // ============================================================================
 // Day 10 Tests
 // ============================================================================
@@ -200,6 +339,75 @@ TEST(DayTests, Day10) {
     EXPECT_EQ(part2_result, "Not implemented");
 }
 
+TEST(DayTests, Day10LayeredSweep) {
+    const std::vector<std::string> example = {
+        "89010123", "78121874", "87430965", "96549874",
+        "45678903", "32019012", "01329801", "10456732",
+    };
+    const auto totals = aoc::day10::analyze_trails(example);
+
+    EXPECT_EQ(totals.score_sum, 36);
+    EXPECT_EQ(totals.rating_sum, 81);
+}
+
+TEST(DayTests, Day10SparseSweepMatchesDense) {
+    const std::vector<std::string> example = {
+        "89010123", "78121874", "87430965", "96549874",
+        "45678903", "32019012", "01329801", "10456732",
+    };
+    // A zero budget forces the sorted-list path
+    const auto dense = aoc::day10::analyze_trails(example);
+    const auto sparse = aoc::day10::analyze_trails(example, 0);
+
+    EXPECT_EQ(sparse.score_sum, 36);
+    EXPECT_EQ(sparse.rating_sum, 81);
+    EXPECT_EQ(sparse.score_sum, dense.score_sum);
+    EXPECT_EQ(sparse.rating_sum, dense.rating_sum);
+}
+
+TEST(DayTests, Day10IncrementalEdits) {
+    std::vector<std::string> grid = {
+        "89010123", "78121874", "87430965", "96549874",
+        "45678903", "32019012", "01329801", "10456732",
+    };
+    aoc::day10::TrailIndex index(grid);
+    EXPECT_EQ(index.total_score(), 36);
+    EXPECT_EQ(index.total_rating(), 81);
+
+    // Every edit must leave the index identical to one rebuilt from scratch
+    const std::string values = "0123456789.";
+    unsigned state = 12345;
+    for (int edit = 0; edit < 300; ++edit) {
+        state = state * 1103515245u + 12345u;
+        const int row = static_cast<int>((state >> 8) % grid.size());
+        const int col = static_cast<int>((state >> 16) % grid[0].size());
+        const char height = values[(state >> 4) % values.size()];
+        grid[row][col] = height;
+        index.set_height(row, col, height);
+
+        const aoc::day10::TrailIndex fresh(grid);
+        ASSERT_EQ(index.total_score(), fresh.total_score());
+        ASSERT_EQ(index.total_rating(), fresh.total_rating());
+        for (int r = 0; r < static_cast<int>(grid.size()); ++r) {
+            for (int c = 0; c < static_cast<int>(grid[r].size()); ++c) {
+                ASSERT_EQ(index.rating(r, c), fresh.rating(r, c));
+                ASSERT_EQ(index.score(r, c), fresh.score(r, c));
+                ASSERT_EQ(index.trails_ending_at(r, c), fresh.trails_ending_at(r, c));
+            }
+        }
+    }
+}
+
+TEST(DayTests, Day10RejectsCellsOutsideMap) {
+    aoc::day10::TrailIndex index({"0123", "1234", "9876"});
+
+    EXPECT_THROW((void)index.rating(3, 0), std::invalid_argument);
+    EXPECT_THROW((void)index.score(0, -1), std::invalid_argument);
+    EXPECT_THROW((void)index.trails_ending_at(-1, 2), std::invalid_argument);
+    EXPECT_THROW(index.set_height(0, 4, '5'), std::invalid_argument);
+    EXPECT_EQ(index.total_rating(), aoc::day10::TrailIndex({"0123", "1234", "9876"}).total_rating());
+}
+
 // ============================================================================
 // Day 11 Tests
 // ============================================================================
@@ -215,6 +423,47 @@ TEST(DayTests, Day11) {
     EXPECT_EQ(part2_result, "Not implemented");
 }
 
+TEST(DayTests, Day11BlinkEngine) {
+    aoc::day11::BlinkEngine engine({125, 17});
+    engine.blink(6);
+    EXPECT_EQ(engine.stone_count(), 22u);
+    engine.blink(19);
+    EXPECT_EQ(engine.stone_count(), 55312u);
+
+    // The set of reachable values closes, so long runs stay cheap
+    engine.blink(2000);
+    EXPECT_LT(engine.distinct_values(), 10000u);
+}
+
+TEST(DayTests, Day11ArbitraryDepth) {
+    const std::vector<std::uint64_t> stones{125, 17};
+    constexpr std::uint64_t kMersenne61 = (std::uint64_t{1} << 61) - 1;
+    EXPECT_EQ(aoc::day11::count_stones_mod(stones, 75, kMersenne61), 65601038650482u);
+    EXPECT_EQ(aoc::day11::count_stones_exact(stones, 75), "65601038650482");
+
+    // Past the recurrence warm-up the jump must agree with the exact walk
+    constexpr std::uint64_t kPrime = 1000000007;
+    const std::string exact = aoc::day11::count_stones_exact(stones, 1500);
+    std::uint64_t expected = 0;
+    for (const char digit : exact) expected = (expected * 10 + static_cast<std::uint64_t>(digit - '0')) % kPrime;
+    EXPECT_EQ(aoc::day11::count_stones_mod(stones, 1500, kPrime), expected);
+
+    EXPECT_LT(aoc::day11::count_stones_mod(stones, 1000000000000ULL, kPrime), kPrime);
+    EXPECT_THROW((void)aoc::day11::count_stones_mod(stones, 10, std::uint64_t{1} << 62), std::invalid_argument);
+}
+
+TEST(DayTests, Day11ParallelBlink) {
+    std::vector<std::uint64_t> stones;
+    for (std::uint64_t value = 0; value < 5000; ++value) stones.push_back(value * 7919 % 100003);
+
+    aoc::day11::BlinkEngine engine(stones);
+    engine.blink(40);
+    for (const unsigned threads : {1u, 3u, 4u}) {
+        EXPECT_EQ(aoc::day11::count_stones_parallel(stones, 40, threads), engine.stone_count());
+    }
+    EXPECT_EQ(aoc::day11::count_stones_parallel({125, 17}, 25, 2), 55312u);
+}
+
 // ============================================================================
 // Day 12 Tests
 // ============================================================================
@@ -230,6 +479,73 @@ TEST(DayTests, Day12) {
     EXPECT_EQ(part2_result, "Not implemented");
 }
 
+TEST(DayTests, Day12SinglePassLabeling) {
+    const std::vector<std::string> small{"AAAA", "BBCD", "BBCC", "EEEC"};
+    EXPECT_EQ(aoc::day12::solve_part1(small), "140");
+    EXPECT_EQ(aoc::day12::solve_part2(small), "80");
+    EXPECT_EQ(aoc::day12::analyze_regions(small).size(), 5u);
+
+    // Diagonal-only contact between two regions of the same plant
+    const std::vector<std::string> diagonal{"AAABBB", "AAABBB", "AAABBB", "BBBAAA", "BBBAAA", "BBBAAA"};
+    EXPECT_EQ(aoc::day12::solve_part2(diagonal), "144");
+    const std::vector<std::string> enclosed{"AAAAAA", "AAABBA", "AAABBA", "ABBAAA", "ABBAAA", "AAAAAA"};
+    EXPECT_EQ(aoc::day12::solve_part2(enclosed), "368");
+
+    const std::vector<std::string> larger{"RRRRIICCFF", "RRRRIICCCF", "VVRRRCCFFF", "VVRCCCJFFF", "VVVVCJJCFE",
+                                          "VVIVCCJJEE", "VVIIICJJEE", "MIIIIIJJEE", "MIIISIJEEE", "MMMISSJEEE"};
+    EXPECT_EQ(aoc::day12::solve_part1(larger), "1930");
+    EXPECT_EQ(aoc::day12::solve_part2(larger), "1206");
+}
+
+TEST(DayTests, Day12TiledLabeling) {
+    // Few plants and thin bands so regions and diagonal corners cross seams
+    std::vector<std::string> grid(37, std::string(29, 'A'));
+    std::uint32_t state = 12345;
+    for (auto& row : grid) {
+        for (auto& plant : row) {
+            state = state * 1103515245u + 12345u;
+            plant = static_cast<char>('A' + (state >> 16) % 3);
+        }
+    }
+
+    const auto serial = aoc::day12::analyze_regions(grid);
+    for (const unsigned threads : {1u, 2u, 5u, 37u, 64u}) {
+        const auto tiled = aoc::day12::analyze_regions_parallel(grid, threads);
+        ASSERT_EQ(tiled.size(), serial.size());
+        for (std::size_t i = 0; i < serial.size(); ++i) {
+            EXPECT_EQ(tiled[i].plant, serial[i].plant);
+            EXPECT_EQ(tiled[i].area, serial[i].area);
+            EXPECT_EQ(tiled[i].perimeter, serial[i].perimeter);
+            EXPECT_EQ(tiled[i].sides, serial[i].sides);
+        }
+    }
+}
+
+TEST(DayTests, Day12IncrementalEdits) {
+    std::vector<std::string> grid(14, std::string(17, 'A'));
+    std::uint32_t state = 777;
+    auto next = [&state] {
+        state = state * 1103515245u + 12345u;
+        return state >> 16;
+    };
+    for (auto& row : grid) {
+        for (auto& plant : row) plant = static_cast<char>('A' + next() % 3);
+    }
+
+    aoc::day12::GardenIndex index(grid);
+    for (int edit = 0; edit < 400; ++edit) {
+        const std::size_t r = next() % grid.size();
+        const std::size_t c = next() % grid[0].size();
+        grid[r][c] = static_cast<char>('A' + next() % 3);
+        index.set_plant(r, c, grid[r][c]);
+
+        ASSERT_EQ(std::to_string(index.perimeter_price()), aoc::day12::solve_part1(grid)) << "edit " << edit;
+        ASSERT_EQ(std::to_string(index.sides_price()), aoc::day12::solve_part2(grid)) << "edit " << edit;
+        ASSERT_EQ(index.region_count(), aoc::day12::analyze_regions(grid).size()) << "edit " << edit;
+    }
+    EXPECT_THROW(index.set_plant(grid.size(), 0, 'A'), std::out_of_range);
+}
+
 // ============================================================================
 // Day 13 Tests
 // ============================================================================
@@ -245,6 +561,30 @@ TEST(DayTests, Day13) {
     EXPECT_EQ(part2_result, "Not implemented");
 }
 
+TEST(DayTests, Day13BatchSolver) {
+    const std::vector<std::string> example{
+        "Button A: X+94, Y+34", "Button B: X+22, Y+67", "Prize: X=8400, Y=5400", "",
+        "Button A: X+26, Y+66", "Button B: X+67, Y+21", "Prize: X=12748, Y=12176", "",
+        "Button A: X+17, Y+86", "Button B: X+84, Y+37", "Prize: X=7870, Y=6450", "",
+        "Button A: X+69, Y+23", "Button B: X+27, Y+71", "Prize: X=18641, Y=10279"};
+    EXPECT_EQ(aoc::day13::solve_part1(example), "480");
+    EXPECT_EQ(aoc::day13::solve_part2(example), "875318608908");
+
+    // Parallel buttons: B alone (5 presses) beats any use of A
+    const std::vector<std::string> parallel{"Button A: X+1, Y+1", "Button B: X+2, Y+2", "Prize: X=10, Y=10"};
+    EXPECT_EQ(aoc::day13::solve_part1(parallel), "5");
+    // Off the common line, or unreachable by the lattice
+    EXPECT_EQ(aoc::day13::solve_part1({"Button A: X+1, Y+1", "Button B: X+2, Y+2", "Prize: X=10, Y=11"}), "0");
+    EXPECT_EQ(aoc::day13::solve_part1({"Button A: X+2, Y+2", "Button B: X+4, Y+4", "Prize: X=7, Y=7"}), "0");
+    // The press limit forces 50 A presses next to 100 B presses
+    EXPECT_EQ(aoc::day13::solve_part1({"Button A: X+1, Y+1", "Button B: X+1, Y+1", "Prize: X=150, Y=150"}), "250");
+
+    // Coordinates whose Cramer products exceed 64 bits
+    const auto machines = aoc::day13::parse_machine_columns(
+        {"Button A: X+3000000000, Y+1", "Button B: X+1, Y+3000000000", "Prize: X=9000000001, Y=3000000003"});
+    EXPECT_EQ(aoc::utils::to_string(aoc::day13::total_min_tokens(machines, 0)), "10");
+}
+
 // ============================================================================
 // Day 14 Tests
 // ============================================================================
@@ -260,6 +600,82 @@ TEST(DayTests, Day14) {
     EXPECT_EQ(part2_result, "Not implemented");
 }
 
+TEST(DayTests, Day14ClusterTime) {
+    // Robots that sit in a small blob at `target` and wander elsewhere
+    auto make_robots = [](const int width, const int height, const long long target) {
+        std::vector<aoc::day14::Robot> robots;
+        std::uint32_t state = 99;
+        auto next = [&state] {
+            state = state * 1103515245u + 12345u;
+            return static_cast<int>(state >> 16);
+        };
+        for (int i = 0; i < 300; ++i) {
+            const int x = width / 2 + next() % 5;
+            const int y = height / 2 + next() % 5;
+            const int vx = next() % 41 - 20;
+            const int vy = next() % 41 - 20;
+            const long long x0 = ((x - static_cast<long long>(vx) * target) % width + width) % width;
+            const long long y0 = ((y - static_cast<long long>(vy) * target) % height + height) % height;
+            robots.push_back({static_cast<int>(x0), static_cast<int>(y0), vx, vy});
+        }
+        return robots;
+    };
+
+    EXPECT_EQ(aoc::day14::find_cluster_time(make_robots(101, 103, 7603), 101, 103), 7603);
+    EXPECT_EQ(aoc::day14::find_cluster_time(make_robots(31, 37, 1000), 31, 37), 1000);
+    // Sizes sharing a factor: the answer is unique modulo lcm(30, 36) = 180
+    EXPECT_EQ(aoc::day14::find_cluster_time(make_robots(30, 36, 1000), 30, 36), 1000 % 180);
+    // lcm(50021, 50023) is above 2^31, and so is the answer
+    EXPECT_EQ(aoc::day14::find_cluster_time(make_robots(50021, 50023, 2400000123LL), 50021, 50023), 2400000123LL);
+}
+
+TEST(DayTests, Day14RobotSwarm) {
+    const std::vector<std::string> example{"p=0,4 v=3,-3", "p=6,3 v=-1,-3", "p=10,3 v=-1,2", "p=2,0 v=2,-1",
+                                           "p=0,0 v=1,3",  "p=3,0 v=-2,-2", "p=7,6 v=-1,-3", "p=3,0 v=-1,-2",
+                                           "p=9,3 v=2,3",  "p=7,3 v=-1,2",  "p=2,4 v=2,-3", "p=9,5 v=-3,-3"};
+    const auto robots = aoc::day14::parse_input(example);
+
+    aoc::day14::RobotSwarm jumped(robots, 11, 7);
+    jumped.advance(100);
+    EXPECT_EQ(jumped.safety_factor(), 12);
+
+    aoc::day14::RobotSwarm stepped(robots, 11, 7);
+    for (int t = 1; t <= 100; ++t) {
+        stepped.advance();
+        for (std::size_t i = 0; i < robots.size(); ++i) {
+            const auto [x, y] = aoc::day14::simulate_movement(robots[i], t, 11, 7);
+            ASSERT_EQ(stepped.xs()[i], x);
+            ASSERT_EQ(stepped.ys()[i], y);
+        }
+    }
+    EXPECT_EQ(stepped.quadrant_counts(), jumped.quadrant_counts());
+}
+
+TEST(DayTests, Day14FrameMetrics) {
+    const auto robots = aoc::day14::parse_input(aoc::utils::read_input(get_input_path("day14.txt")));
+
+    // Random frames stay far below these scores; the picture clears all three
+    EXPECT_EQ(aoc::day14::find_first_frame(robots, 101, 103, aoc::day14::longest_row_run_metric(), 20, 10403, 1),
+              7603);
+    EXPECT_EQ(aoc::day14::find_first_frame(robots, 101, 103, aoc::day14::adjacency_metric(), 250, 10403, 4), 7603);
+    EXPECT_EQ(aoc::day14::find_first_frame(robots, 101, 103, aoc::day14::block_entropy_metric(), 1.5, 10403, 3),
+              7603);
+    EXPECT_EQ(aoc::day14::find_first_frame(robots, 101, 103, aoc::day14::longest_row_run_metric(), 20, 7603, 2),
+              std::nullopt);
+
+    // Runs that cross a 64-bit word boundary
+    aoc::day14::RobotSwarm line({{60, 0, 0, 0}, {61, 0, 0, 0}, {62, 0, 0, 0}, {63, 0, 0, 0}, {64, 0, 0, 0},
+                                 {65, 0, 0, 0}, {65, 1, 0, 0}},
+                                130, 2);
+    aoc::day14::OccupancyFrame frame(130, 2);
+    frame.load(line);
+    EXPECT_EQ(aoc::day14::longest_row_run_metric()(frame), 6.0);
+    EXPECT_EQ(aoc::day14::adjacency_metric()(frame), 6.0);
+    // 3-wide blocks: columns 60-62 hold 3 cells, 63-65 (across the word boundary) hold 4, of 44 blocks
+    EXPECT_NEAR(aoc::day14::block_entropy_metric(3)(frame), 4.474203482603046, 1e-9);
+    EXPECT_THROW((void)aoc::day14::block_entropy_metric(0), std::invalid_argument);
+}
+
 // ============================================================================
 // Day 15 Tests
 // ============================================================================
@@ -275,6 +691,117 @@ TEST(DayTests, Day15) {
     EXPECT_EQ(part2_result, "Not implemented");
 }
 
+/**
+ * @brief The larger example warehouse from the puzzle description
+ */
+static std::vector<std::string> day15_example() {
+    return {"##########",
+            "#..O..O.O#",
+            "#......O.#",
+            "#.OO..O.O#",
+            "#..O@..O.#",
+            "#O#..O...#",
+            "#O..O..O.#",
+            "#.OO.O.OO#",
+            "#....O...#",
+            "##########",
+            "",
+            "<vv>^<v^>v>^vv^v>v<>v^v<v<^vv<<<^><<><>>v<vvv<>^v^>^<<<><<v<<<v^vv^v>^",
+            "vvv<<^>^v^^><<>>><>^<<><^vv^^<>vvv<>><^^v>^>vv<>v<<<<v<^v>^<^^>>>^<v<v",
+            "><>vv>v^v^<>><>>>><^^>vv>v<^^^>>v^v^<^^>v^^>v^<^v>v<>>v^v^<v>v^^<^^vv<",
+            "<<v<^>>^^^^>>>v^<>vvv^><v<<<>^^^vv^<vvv>^>v<^^^^v<>^>vvvv><>>v^<<^^^^^",
+            "^><^><>>><>^^<<^^v>>><^<v>^<vv>>v>>>^v><>^v><<<<v>>v<v<v>vvv>^<><<>^><",
+            "^>><>^v<><^vvv<^^<><v<<<<<><^v<<<><<<^^<v<^^^><^>>^<v^><<<^>>^v<v^v<v^",
+            ">^>>^v>vv>^<<^v<>><<><<v<<v><>v<^vv<<<>^^v^>^^>>><<^v>>v^v><^^>>^<>vv^",
+            "<><^^>^^^<><vvvvv^v<v<<>^v<v>v<<^><<><<><<<^^<<<^<<>><<><^^^>^^<>^>v<>",
+            "^^>vv<^v^v<vv>^<><v<^v>^^^>>>^^vvv^>vvv<>>>^<^>>>>>^<<^v>^vvv<>^<><<v>",
+            "v^^>>><<^^<>>^v^<v^vv<>v^<<>^<^v^v><^<<<><<^<v><v<>vv>>v><v^<vv<>v^<<^"};
+}
+
+TEST(DayTests, Day15FlatWarehouse) {
+    const auto input = day15_example();
+    EXPECT_EQ(aoc::day15::solve_part1(input), "10092");
+    EXPECT_EQ(aoc::day15::solve_part2(input), "9021");
+
+    // The row-based reference and the flat simulator agree after every move
+    auto [raw, instructions] = aoc::day15::parse_input(input);
+    auto reference = aoc::day15::expand_warehouse(raw);
+    aoc::day15::FlatWarehouse flat(reference);
+    for (const char c : instructions) {
+        const auto dir = aoc::day15::char_to_direction(c);
+        ASSERT_TRUE(dir.has_value());
+        ASSERT_EQ(flat.move(*dir), aoc::day15::try_move_part2(reference, *dir));
+        ASSERT_EQ(flat.to_warehouse().grid, reference.grid);
+        ASSERT_EQ(flat.robot(), reference.robot_pos);
+        ASSERT_EQ(flat.at(flat.robot()), '@');
+    }
+}
+
+TEST(DayTests, Day15Streaming) {
+    const auto input = day15_example();
+    {
+        std::ofstream file("temp_day15_stream.txt");
+        for (const auto& line : input) file << line << '\n';
+    }
+
+    std::vector<std::uint64_t> checkpoint_moves;
+    std::optional<aoc::day15::FlatWarehouse> at_300;
+    const auto narrow = aoc::day15::simulate_stream(
+        "temp_day15_stream.txt", false, 100,
+        [&](const aoc::day15::WarehouseCheckpoint& checkpoint) {
+            checkpoint_moves.push_back(checkpoint.moves_applied);
+            if (checkpoint.moves_applied == 300) at_300.emplace(checkpoint.state);
+        },
+        7);
+    EXPECT_EQ(narrow.gps_sum(), 10092);
+    EXPECT_EQ(checkpoint_moves, (std::vector<std::uint64_t>{100, 200, 300, 400, 500, 600, 700}));
+
+    // The snapshot matches an in-memory run stopped after 300 moves
+    auto [raw, instructions] = aoc::day15::parse_input(input);
+    aoc::day15::FlatWarehouse replay(raw);
+    for (std::size_t i = 0; i < 300; ++i) replay.move(*aoc::day15::char_to_direction(instructions[i]));
+    ASSERT_TRUE(at_300.has_value());
+    EXPECT_EQ(at_300->to_warehouse().grid, replay.to_warehouse().grid);
+
+    EXPECT_EQ(aoc::day15::simulate_stream("temp_day15_stream.txt", true).gps_sum(), 9021);
+    std::remove("temp_day15_stream.txt");
+}
+
+TEST(DayTests, Day15UndoAndPlans) {
+    auto [raw, instructions] = aoc::day15::parse_input(day15_example());
+    aoc::day15::FlatWarehouse warehouse(aoc::day15::expand_warehouse(raw));
+    warehouse.apply(std::string_view(instructions).substr(0, 200));
+    const auto before = warehouse.to_warehouse();
+
+    // Nested branches roll back exactly, including the running GPS sum
+    const auto outer = warehouse.checkpoint();
+    warehouse.apply(std::string_view(instructions).substr(200, 150));
+    const auto middle_grid = warehouse.to_warehouse().grid;
+    const auto inner = warehouse.checkpoint();
+    warehouse.apply(std::string_view(instructions).substr(350));
+    EXPECT_EQ(warehouse.gps_sum(), 9021);
+    warehouse.rollback(inner);
+    EXPECT_EQ(warehouse.to_warehouse().grid, middle_grid);
+    warehouse.rollback(outer);
+    EXPECT_EQ(warehouse.to_warehouse().grid, before.grid);
+    EXPECT_EQ(warehouse.robot(), before.robot_pos);
+    EXPECT_EQ(warehouse.gps_sum(), aoc::day15::calculate_gps_sum(before));
+    warehouse.clear_journal();
+
+    std::vector<std::string> plans;
+    for (std::size_t start = 200; start + 60 <= instructions.size(); start += 37) {
+        plans.push_back(instructions.substr(start, 60));
+    }
+    const auto results = aoc::day15::evaluate_plans(warehouse, plans, 3);
+    ASSERT_EQ(results.size(), plans.size());
+    for (std::size_t i = 0; i < plans.size(); ++i) {
+        aoc::day15::FlatWarehouse copy = warehouse;
+        copy.apply(plans[i]);
+        EXPECT_EQ(results[i], aoc::day15::calculate_gps_sum(copy.to_warehouse()));
+    }
+    EXPECT_EQ(warehouse.to_warehouse().grid, before.grid);
+}
+
 // ============================================================================
 // Day 16 Tests
 // ============================================================================
@@ -285,9 +812,113 @@ TEST(DayTests, Day16) {
     const std::string part1_result = aoc::day16::solve_part1(input);
     const std::string part2_result = aoc::day16::solve_part2(input);
 
-    // TODO: Replace with actual expected results once implemented
-    EXPECT_EQ(part1_result, "Not implemented");
-    EXPECT_EQ(part2_result, "Not implemented");
+    EXPECT_EQ(part1_result, "135536");
+    EXPECT_EQ(part2_result, "583");
+}
+
+/**
+ * @brief The two example mazes from the puzzle description
+ */
+static std::vector<std::string> day16_small_example() {
+    return {"###############",
+            "#.......#....E#",
+            "#.#.###.#.###.#",
+            "#.....#.#...#.#",
+            "#.###.#####.#.#",
+            "#.#.#.......#.#",
+            "#.#.#####.###.#",
+            "#...........#.#",
+            "###.#.#####.#.#",
+            "#...#.....#.#.#",
+            "#.#.#.###.#.#.#",
+            "#.....#...#.#.#",
+            "#.###.#.#.#.#.#",
+            "#S..#.....#...#",
+            "###############"};
+}
+
+static std::vector<std::string> day16_large_example() {
+    return {"#################",
+            "#...#...#...#..E#",
+            "#.#.#.#.#.#.#.#.#",
+            "#.#.#.#...#...#.#",
+            "#.#.#.#.###.#.#.#",
+            "#...#.#.#.....#.#",
+            "#.#.#.#.#.#####.#",
+            "#.#...#.#.#.....#",
+            "#.#.#####.#.###.#",
+            "#.#.#.......#...#",
+            "#.#.###.#####.###",
+            "#.#.#...#.....#.#",
+            "#.#.#.#####.###.#",
+            "#.#.#.........#.#",
+            "#.#.#.#########.#",
+            "#S#.............#",
+            "#################"};
+}
+
+TEST(DayTests, Day16BucketQueueSearch) {
+    EXPECT_EQ(aoc::day16::solve_part1(day16_small_example()), "7036");
+    EXPECT_EQ(aoc::day16::solve_part2(day16_small_example()), "45");
+    EXPECT_EQ(aoc::day16::solve_part1(day16_large_example()), "11048");
+    EXPECT_EQ(aoc::day16::solve_part2(day16_large_example()), "64");
+
+    // Distances agree in both directions: from S to E equals E's cost-to-go from S
+    const auto maze = aoc::day16::parse_maze(day16_small_example());
+    const auto to_end = aoc::day16::distances_to_end(maze);
+    EXPECT_EQ(to_end[aoc::day16::state_index(maze.start, aoc::day16::Heading::East)], 7036u);
+
+    // A walled-off end is reported rather than answered
+    const std::vector<std::string> sealed = {"#####", "#S#E#", "#####"};
+    EXPECT_THROW((void)aoc::day16::solve_maze(aoc::day16::parse_maze(sealed)), std::runtime_error);
+}
+
+TEST(DayTests, Day16ContractedGraph) {
+    const std::vector<std::vector<std::string>> mazes = {
+        day16_small_example(), day16_large_example(),
+        aoc::utils::read_input(get_input_path("day16.txt"))};
+    for (const auto& input : mazes) {
+        const auto maze = aoc::day16::parse_maze(input);
+        const auto flat = aoc::day16::solve_maze(maze);
+        const auto contracted = aoc::day16::solve_maze_contracted(maze);
+        EXPECT_EQ(contracted.best_score, flat.best_score);
+        EXPECT_EQ(contracted.best_path_tiles, flat.best_path_tiles);
+    }
+}
+
+TEST(DayTests, Day16Bidirectional) {
+    std::vector<std::vector<std::string>> mazes = {
+        day16_small_example(), day16_large_example(),
+        aoc::utils::read_input(get_input_path("day16.txt"))};
+
+    // Open random fields have many tied best paths and meetings mid-turn
+    unsigned long long seed = 12345;
+    for (int n = 6; n < 40; n += 3) {
+        std::vector<std::string> grid(n, std::string(n, '#'));
+        for (int y = 1; y < n - 1; ++y) {
+            for (int x = 1; x < n - 1; ++x) {
+                seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+                grid[y][x] = (seed >> 33) % 5 == 0 ? '#' : '.';
+            }
+        }
+        grid[n - 2][1] = 'S';
+        grid[1][n - 2] = 'E';
+        mazes.push_back(grid);
+    }
+
+    for (const auto& input : mazes) {
+        const auto maze = aoc::day16::parse_maze(input);
+        std::optional<aoc::day16::MazeSolution> single;
+        try {
+            single = aoc::day16::solve_maze(maze);
+        } catch (const std::runtime_error&) {
+            EXPECT_THROW((void)aoc::day16::solve_maze_bidirectional(maze), std::runtime_error);
+            continue;
+        }
+        const auto both = aoc::day16::solve_maze_bidirectional(maze);
+        EXPECT_EQ(both.best_score, single->best_score);
+        EXPECT_EQ(both.best_path_tiles, single->best_path_tiles);
+    }
 }
 
 // ============================================================================
@@ -300,9 +931,38 @@ TEST(DayTests, Day17) {
     const std::string part1_result = aoc::day17::solve_part1(input);
     const std::string part2_result = aoc::day17::solve_part2(input);
 
-    // TODO: Replace with actual expected results once implemented
-    EXPECT_EQ(part1_result, "Not implemented");
-    EXPECT_EQ(part2_result, "Not implemented");
+    EXPECT_EQ(part1_result, "1,6,3,6,5,6,5,1,7");
+    EXPECT_EQ(part2_result, "247839653009594");
+}
+
+TEST(DayTests, Day17ReverseSearch) {
+    // Part 2 example from the puzzle: adv 3, out A, jnz 0
+    const std::vector<std::string> example = {"Register A: 2024", "Register B: 0", "Register C: 0", "",
+                                              "Program: 0,3,5,4,3,0"};
+    EXPECT_EQ(aoc::day17::solve_part2(example), "117440");
+
+    // A program that only consumes one bit of A per pass, searched single-threaded and in parallel
+    const aoc::day17::Program halving{{2, 4, 1, 3, 5, 5, 0, 1, 3, 0}}; // bst A, bxl 3, out B, adv 1, jnz 0
+    const std::vector<int> target = {5, 0, 6, 1, 2};
+    const auto serial = aoc::day17::findRegisterA(halving, target, 0, 0, 1);
+    const auto parallel = aoc::day17::findRegisterA(halving, target, 0, 0, 4);
+    ASSERT_TRUE(serial.has_value());
+    EXPECT_EQ(*serial, 22);
+    EXPECT_EQ(serial, parallel);
+    aoc::day17::Computer computer{halving, *serial, 0, 0};
+    computer.run();
+    EXPECT_EQ(computer.getOutput(), target);
+
+    // Unreachable outputs and programs of another shape are reported
+    EXPECT_FALSE(aoc::day17::findRegisterA(halving, {7}, 0, 0).has_value());
+    EXPECT_THROW((void)aoc::day17::findRegisterA(aoc::day17::Program{{5, 4, 3, 0}}, {0}, 0, 0),
+                 std::invalid_argument);
+
+    // The search places one output per pass, so two outputs (or none) are rejected
+    EXPECT_THROW((void)aoc::day17::findRegisterA(aoc::day17::Program{{2, 4, 5, 5, 5, 5, 0, 3, 3, 0}}, {5, 5}, 0, 0),
+                 std::invalid_argument);
+    EXPECT_THROW((void)aoc::day17::findRegisterA(aoc::day17::Program{{2, 4, 0, 3, 3, 0}}, {0}, 0, 0),
+                 std::invalid_argument);
 }
 
 // ============================================================================
@@ -10,6 +10,7 @@
 
 #include "utils/input_handler.hpp"
 #include "utils/math_utils.hpp"
+#include "utils/maze_graph.hpp"
 #include "utils/string_utils.hpp"
 
 #include <cstdio>
@@ -52,6 +53,32 @@ TEST(InputHandlerTest, ReadInputRaw) {
     std::remove("temp_test_input_raw.txt");
 }
 
+TEST(InputHandlerTest, ChunkedFileReader) {
+    std::ofstream temp_file("temp_test_input_chunked.txt");
+    temp_file << "header one\r\nheader two\n\nabcdefghijklmnopqrstuvwxyz";
+    temp_file.close();
+
+    // A 4-byte buffer forces lines and the body to span several refills
+    aoc::utils::ChunkedFileReader reader("temp_test_input_chunked.txt", 4);
+    std::string line;
+    ASSERT_TRUE(reader.read_line(line));
+    EXPECT_EQ(line, "header one");
+    ASSERT_TRUE(reader.read_line(line));
+    EXPECT_EQ(line, "header two");
+    ASSERT_TRUE(reader.read_line(line));
+    EXPECT_EQ(line, "");
+
+    std::string body;
+    for (auto chunk = reader.next_chunk(); !chunk.empty(); chunk = reader.next_chunk()) {
+        EXPECT_LE(chunk.size(), 4u);
+        body += chunk;
+    }
+    EXPECT_EQ(body, "abcdefghijklmnopqrstuvwxyz");
+    EXPECT_FALSE(reader.read_line(line));
+
+    std::remove("temp_test_input_chunked.txt");
+}
+
 // ============================================================================
 // String Utilities Tests
 // ============================================================================
@@ -136,6 +163,14 @@ TEST(MathUtilsTest, AbsDiff) {
     EXPECT_EQ(aoc::utils::abs_diff(-5, 5), 10);
 }
 
+TEST(MathUtilsTest, Int128ToString) {
+    EXPECT_EQ(aoc::utils::to_string(aoc::utils::int128{0}), "0");
+    EXPECT_EQ(aoc::utils::to_string(aoc::utils::int128{-42}), "-42");
+    const aoc::utils::int128 big = aoc::utils::int128{10000000000000LL} * 10000000000000LL;
+    EXPECT_EQ(aoc::utils::to_string(big), "100000000000000000000000000");
+    EXPECT_EQ(aoc::utils::to_string(-big - 7), "-100000000000000000000000007");
+}
+
 TEST(MathUtilsTest, Sum) {
     const std::vector<int> nums = {1, 2, 3, 4, 5};
     EXPECT_EQ(aoc::utils::sum(nums), 15);
@@ -148,4 +183,54 @@ TEST(MathUtilsTest, MinMax) {
     const std::vector<int> nums = {3, 1, 4, 1, 5, 9, 2, 6};
     EXPECT_EQ(aoc::utils::min(nums), 1);
     EXPECT_EQ(aoc::utils::max(nums), 9);
-}
\ No newline at end of file
+}
+// ============================================================================
+// Maze Graph Tests
+// ============================================================================
+
+TEST(MazeGraphTest, ContractsCorridors) {
+    // ######
+    // #S...#    S kept; the corridor bends down the right side
+    // ####.#
+    // #E...#    E is a dead end, also kept
+    // ######
+    const std::vector<std::string> rows = {"######", "#S...#", "####.#", "#E...#", "######"};
+    std::vector<char> open;
+    for (const auto& row : rows) {
+        for (const char c : row) {
+            open.push_back(c != '#' ? 1 : 0);
+        }
+    }
+    const int width = 6;
+    const int start = 1 * width + 1;
+    const int end = 3 * width + 1;
+    const std::vector<int> keep = {start, end};
+
+    const auto graph = aoc::utils::contract_maze(open, width, keep);
+
+    // Only S and E remain; one corridor, walked both ways
+    ASSERT_EQ(graph.nodes.size(), 2u);
+    ASSERT_EQ(graph.edges.size(), 2u);
+
+    const auto& node = graph.nodes[graph.node_of_cell[start]];
+    const int edge_id = node.out_edge[0];
+    ASSERT_GE(edge_id, 0);
+    const auto& edge = graph.edges[edge_id];
+    EXPECT_EQ(graph.nodes[edge.to].cell, end);
+    EXPECT_EQ(edge.steps, 8);
+    EXPECT_EQ(edge.turns, 2);
+    EXPECT_EQ(edge.entry_heading, 2);
+    EXPECT_EQ(graph.edge_tiles(edge).size(), 7u);
+    EXPECT_EQ(graph.edge_tiles(edge).front(), start + 1);
+    EXPECT_EQ(graph.nodes[edge.to].in_edge[2], edge_id);
+
+    // The twin runs the other way over the same tiles
+    const auto& twin = graph.edges[graph.nodes[edge.to].out_edge[0]];
+    EXPECT_EQ(graph.nodes[twin.to].cell, start);
+    EXPECT_EQ(twin.turns, 2);
+    EXPECT_EQ(graph.edge_tiles(twin).front(), graph.edge_tiles(edge).back());
+
+    EXPECT_THROW((void)aoc::utils::contract_maze(open, 7), std::invalid_argument);
+    const std::vector<int> wall = {0};
+    EXPECT_THROW((void)aoc::utils::contract_maze(open, width, wall), std::invalid_argument);
+}